@@ -1,36 +1,59 @@
 #include <stdio.h>
 #include <string.h>
 #include "AoC64.h"
-#if __has_include("input.h")
+#include "progress.h"
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
 
 
-int main(void) {
-    init(1);
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(lines));
+
+// solves the compiled-in depths, or those of AOC64_INPUT (or of each input of a batch) on the host
+void solve() {
+    const uint16_t* depths = lines;
+    size_t n = sizeof(lines) / sizeof(lines[0]);
+    input_numbers(depths, n);
+    // the sliding windows need 3 depths
+    if (n < 3) {
+        printf("error: %lu depths, at least 3 needed\n", (unsigned long)n);
+        return;
+    }
 
+    phase("part 1");
     int res1 = 0, res2 = 0;
-    const int16_t n = sizeof(lines) / sizeof(lines[0]);
+    Progress<7> progress("lines", 2*n);
 
-    int prev = lines[0], next = 0;
-    for (int i = 0; i < n; ++i) {
-        next = lines[i];
+    int prev = depths[0], next = 0;
+    for (size_t i = 0; i < n; ++i) {
+        next = depths[i];
         res1 = next > prev ? res1 + 1 : res1;
         prev = next;
-        tick((i >> 7) & 7);
+        progress.step();
     }
+    progress.done();
     printf("part 1: %d\n", res1);
 
-    prev = lines[0] + lines[1] + lines[2];
-    for (int i = 1; i < n-2; ++i) {
-        next = lines[i] + lines[i+1] + lines[i+2];
+    phase("part 2");
+    prev = depths[0] + depths[1] + depths[2];
+    for (size_t i = 1; i < n-2; ++i) {
+        next = depths[i] + depths[i+1] + depths[i+2];
         res2 = next > prev ? res2 + 1 : res2;
         prev = next;
-        tick((i >> 7) & 7);
+        progress.step();
     }
+    progress.done();
     printf("part 2: %d\n", res2);
+}
 
+int main(int argc, char** argv) {
+    init(1);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
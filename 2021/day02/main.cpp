@@ -1,30 +1,44 @@
+#include <assert.h>
 #include <cstdlib>
 #include <string.h>
 #include "AoC64.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
 
 
+// the compiled-in commands, or those of AOC64_INPUT on the host (see solve)
+static const char* const* commands = input;
+static size_t n_commands = input_len;
+
+#ifdef __mos6502__
+constexpr uint16_t MAX_COMMANDS = input_len;
+#else
+constexpr uint32_t MAX_COMMANDS = 1 << 20;
+#endif
+
 struct Instruction {
-    const char* direction[input_len];
-    uint8_t distance[input_len];
+    const char* direction[MAX_COMMANDS];
+    uint8_t distance[MAX_COMMANDS];
 } instructions;
 
 
 void parse_input() {
-    for (uint16_t i = 0; i < input_len; ++i) {
-        instructions.direction[i] = &(input[i][0]);
-        instructions.distance[i] = (uint8_t)atoi(strchr(input[i], ' '));
+    assert(n_commands <= MAX_COMMANDS);
+    for (size_t i = 0; i < n_commands; ++i) {
+        instructions.direction[i] = &(commands[i][0]);
+        instructions.distance[i] = (uint8_t)atoi(strchr(commands[i], ' '));
     }
 }
 
 
 uint32_t navigate(const bool part2 = false) {
     uint32_t d = 0, x = 0, aim = 0;
-    for (uint16_t i = 0; i < input_len; ++i) {
+    for (size_t i = 0; i < n_commands; ++i) {
         tick((i >> 7) & 7);
         if (*(instructions.direction[i]) == 'f') {
             x += instructions.distance[i];
@@ -38,14 +52,23 @@ uint32_t navigate(const bool part2 = false) {
     return x*d;
 }
 
-int main(void) {
-    init(2);
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(input), decltype(commands), decltype(n_commands), decltype(instructions));
+
+void solve() {
+    input_lines(commands, n_commands);
 
-    parse_input();
+    { AOC64_PHASE("parse"); parse_input(); }
 
+    phase("part 1");
     printf("part 1: %lu\n", navigate());
+    phase("part 2");
     printf("part 2: %lu\n", navigate(true));
+}
 
+int main(int argc, char** argv) {
+    init(2);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
     return 0;
 }
\ No newline at end of file
@@ -1,22 +1,40 @@
+#include <assert.h>
 #include <string.h>
 #include "AoC64.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
 
+// the compiled-in report, or that of AOC64_INPUT on the host (see solve)
+static const char* const* report = input;
+static size_t n_report = input_len;
 
-int8_t most_common_digit(const uint8_t digit, const uint16_t* idx = NULL, const uint16_t size = input_len)
+#ifdef __mos6502__
+typedef uint16_t Index;
+constexpr Index MAX_REPORT = input_len;
+#else
+typedef uint32_t Index;
+constexpr Index MAX_REPORT = 1 << 20;
+#endif
+// the numbers left for the oxygen generator and the CO2 scrubber ratings
+static Index idx_o2[MAX_REPORT];
+static Index idx_co2[MAX_REPORT];
+
+
+int8_t most_common_digit(const uint8_t digit, const Index* idx, const size_t size)
 {
-    uint16_t res = 0;
+    size_t res = 0;
     if (idx == NULL) {
-        for (uint16_t i = 0; i < size; ++i) {
-            res += input[i][digit] == '1' ? 1 : 0;
+        for (size_t i = 0; i < size; ++i) {
+            res += report[i][digit] == '1' ? 1 : 0;
         }
     } else {
-        for (uint16_t i = 0; i < size; ++i) {
-            res += input[idx[i]][digit] == '1' ? 1 : 0;
+        for (size_t i = 0; i < size; ++i) {
+            res += report[idx[i]][digit] == '1' ? 1 : 0;
         }
     }
     return 2*res > size ? 1 : (2*res == size ? 0 : -1);
@@ -24,7 +42,7 @@ int8_t most_common_digit(const uint8_t digit, const uint16_t* idx = NULL, const
 
 uint16_t get_bitmask(const uint16_t len)
 {
-    return (~(uint16_t(0U))) >> ((sizeof(uint16_t) << 3) - len);
+    return (uint16_t)0xFFFF >> ((sizeof(uint16_t) << 3) - len);
 }
 
 uint16_t to_number(const char* number) {
@@ -36,16 +54,22 @@ uint16_t to_number(const char* number) {
     return ret;
 }
 
-int main(void)
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(input), decltype(report), decltype(n_report), decltype(idx_o2),
+             decltype(idx_co2));
+
+void solve()
 {
-    init(3);
-    const uint8_t ndigits = strlen(input[0]);
+    input_lines(report, n_report);
+    assert(n_report <= MAX_REPORT);
+
+    phase("part 1");
+    const uint8_t ndigits = strlen(report[0]);
 
     // part 1
     uint16_t res = 0;
     for (uint8_t i = 0; i < ndigits; ++i) {
         tick(i & (uint8_t)7);
-        res |= (most_common_digit(i) > 0) << (ndigits - 1 - i);
+        res |= (most_common_digit(i, NULL, n_report) > 0) << (ndigits - 1 - i);
     }
     uint32_t gamma = res;
     uint32_t epsilon = ~gamma & get_bitmask(ndigits);
@@ -53,22 +77,21 @@ int main(void)
 
 
     // part 2
-    uint16_t n_o2 = input_len;
-    uint16_t n_co2 = input_len;
-    uint16_t idx_o2[input_len];
-    uint16_t idx_co2[input_len];
-    for (uint16_t i = 0; i < input_len; ++i) {
+    phase("part 2");
+    size_t n_o2 = n_report;
+    size_t n_co2 = n_report;
+    for (size_t i = 0; i < n_report; ++i) {
         idx_o2[i] = i;
         idx_co2[i] = i;
     }
     for (uint8_t d = 0;  d < ndigits; ++d) {
         tick(d & (uint8_t)7);
         if (n_o2 > 1) {
-            uint16_t i_o2 = 0;
+            size_t i_o2 = 0;
             const int8_t m = most_common_digit(d, idx_o2, n_o2);
-            for (uint16_t i = 0; i < n_o2; ++i) {
-                const uint16_t idx = idx_o2[i];
-                const char digit = input[idx][d];
+            for (size_t i = 0; i < n_o2; ++i) {
+                const Index idx = idx_o2[i];
+                const char digit = report[idx][d];
                 if ((m >= 0 && digit == '1') || (m == -1 && digit == '0')) {
                     idx_o2[i_o2++] = idx;
                 }
@@ -76,11 +99,11 @@ int main(void)
             n_o2 = i_o2;
         }
         if (n_co2 > 1) {
-            uint16_t i_co2 = 0;
+            size_t i_co2 = 0;
             const int8_t m = most_common_digit(d, idx_co2, n_co2);
-            for (uint16_t i = 0; i < n_co2; ++i) {
-                const uint16_t idx = idx_co2[i];
-                const char digit = input[idx][d];
+            for (size_t i = 0; i < n_co2; ++i) {
+                const Index idx = idx_co2[i];
+                const char digit = report[idx][d];
                 if ((m >= 0 && digit == '0') || (m == -1 && digit == '1')) {
                     idx_co2[i_co2++] = idx;
                 }
@@ -89,10 +112,16 @@ int main(void)
         }
     }
 
-    uint32_t o2 = to_number(input[idx_o2[0]]);
-    uint32_t co2 = to_number(input[idx_co2[0]]);
+    uint32_t o2 = to_number(report[idx_o2[0]]);
+    uint32_t co2 = to_number(report[idx_co2[0]]);
     printf("part 2: %lu\n", o2*co2);
+}
 
+int main(int argc, char** argv)
+{
+    init(3);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
     return 0;
 }
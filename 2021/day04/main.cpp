@@ -1,18 +1,35 @@
+#include <assert.h>
 #include <cstdio>
+#include <stdlib.h>
 #include <string.h>
 #include "../lib/AoC64.h"
-#include "input.h"
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
+  #include "input.h"          // user’s private input (gitignored)
+#else
+  #include "input.example.h"  // checked-in sample input
+#endif
 
-constexpr uint8_t n_bingos = sizeof(bingos)/sizeof(bingos[0]);
-constexpr uint8_t n_numbers = sizeof(numbers)/sizeof(numbers[0]);
-uint8_t win[n_bingos];
-uint8_t when[n_bingos];
-uint8_t hit[n_bingos][5][5] = {{{}}};
+// the compiled-in boards and numbers, or those of AOC64_INPUT on the host (see parse_input)
+static const uint8_t (*boards)[5][5] = bingos;
+static const uint8_t* draws = numbers;
+static uint8_t n_bingos = sizeof(bingos)/sizeof(bingos[0]);
+static uint8_t n_numbers = sizeof(numbers)/sizeof(numbers[0]);
+
+#ifdef __mos6502__
+constexpr uint8_t MAX_BINGOS = sizeof(bingos)/sizeof(bingos[0]);
+#else
+constexpr uint8_t MAX_BINGOS = 255;
+#endif
+uint8_t win[MAX_BINGOS];
+uint8_t when[MAX_BINGOS];
+uint8_t hit[MAX_BINGOS][5][5];
 
 void mark(const uint8_t b, const uint8_t n) {
     for (uint8_t i = 0; i < 5; ++i) {
         for (uint8_t j = 0; j < 5; ++j) {
-            if (bingos[b][i][j] == n) {
+            if (boards[b][i][j] == n) {
                 hit[b][i][j] = 1;
                 return;
             }
@@ -25,7 +42,7 @@ uint16_t score(const uint8_t b, const uint8_t n) {
     for (uint8_t i = 0; i < 5; ++i) {
         for (uint8_t j = 0; j < 5; ++j) {
             if (hit[b][i][j] == 0) {
-                s += bingos[b][i][j];
+                s += boards[b][i][j];
             }
         }
     }
@@ -49,20 +66,64 @@ uint8_t check_bingo(const uint8_t b) {
 }
 
 void play_bingo() {
+    // clean cards, also for the next inputs of a batch
+    memset(win, 0, sizeof(win));
+    memset(hit, 0, sizeof(hit));
     for (uint8_t i = 0; i < n_numbers; ++i) {
         tick(i & (uint8_t)7);
         for (int b = 0; b < n_bingos; ++b) {
             if (win[b]) continue;
-            mark(b, numbers[i]);
+            mark(b, draws[i]);
             win[b] = check_bingo(b);
             when[b] = i;
         }
     }
 }
 
-int main(void) {
-    init(4);
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(bingos), decltype(numbers), decltype(boards), decltype(draws),
+             decltype(n_bingos), decltype(n_numbers), decltype(win), decltype(when), decltype(hit));
+
+#ifndef __mos6502__
+static uint8_t file_draws[255];
+static uint8_t file_boards[MAX_BINGOS][5][5];
 
+// the numbers (first line) and the boards of AOC64_INPUT, false if it is not set
+bool parse_input() {
+    char* const* lines;
+    size_t n;
+    if (!input_lines(lines, n))
+        return false;
+    AOC64_PHASE("parse");
+    char* p = lines[0];
+    for (n_numbers = 0; *p; ++n_numbers) {
+        assert(n_numbers < sizeof(file_draws));
+        file_draws[n_numbers] = strtoul(p, &p, 10);
+        p += *p == ',';
+    }
+    uint8_t row = 0;
+    n_bingos = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (*lines[i] == 0)
+            continue;
+        assert(n_bingos < MAX_BINGOS);
+        p = lines[i];
+        for (uint8_t j = 0; j < 5; ++j)
+            file_boards[n_bingos][row][j] = strtoul(p, &p, 10);
+        if (++row == 5) {
+            row = 0;
+            ++n_bingos;
+        }
+    }
+    boards = file_boards;
+    draws = file_draws;
+    return true;
+}
+#endif
+
+void solve() {
+#ifndef __mos6502__
+    parse_input();
+#endif
     play_bingo();
     uint8_t min = n_numbers;
     uint8_t max = 0;
@@ -72,8 +133,14 @@ int main(void) {
         if (when[b] > max) { max = when[b]; loosing = b; }
     }
 
-    printf("part 1: %u\n",score(winning, numbers[when[winning]]));
-    printf("part 2: %u\n", score(loosing, numbers[when[loosing]]));
+    printf("part 1: %u\n",score(winning, draws[when[winning]]));
+    printf("part 2: %u\n", score(loosing, draws[when[loosing]]));
+}
 
+int main(int argc, char** argv) {
+    init(4);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
@@ -1,20 +1,30 @@
 #include <cstdio>
+#include <assert.h>
 #include <string.h>
 #include "AoC64.h"
 #include "reucpy.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
+#ifndef __mos6502__
+  #include "sweep.h"
+#endif
 
 inline int16_t min(const int16_t a, const int16_t b) { return a > b ? b : a; }
 inline int16_t max(const int16_t a, const int16_t b) { return a < b ? b : a; }
 #define SWAP(a, b) do { int16_t tmp = (a); (a) = (b); (b) = tmp; } while(0)
 
+// the compiled-in lines, or those of AOC64_INPUT (or of each input of a batch) on the host (see solve)
+static int16_t (*segments)[4] = lines;
+static size_t n_segments = n_lines;
+
 void orient(void) {
-   for (int16_t i = 0; i < n_lines; ++i) {
-        int16_t* const l = lines[i];
+   for (size_t i = 0; i < n_segments; ++i) {
+        int16_t* const l = segments[i];
         if (l[0] > l[2]) {
             SWAP(l[0], l[2]);
             if (l[1] != l[3]) {
@@ -26,102 +36,280 @@ void orient(void) {
     }
 }
 
-int main(void) {
-    init(5);
-    reuset(0, 0, 1);
+// the field is processed in tiles of stride x stride cells, counting the lines over each cell
+constexpr int8_t stride = 64;
+static uint8_t S1[stride][stride]; // 4KB, horizontal and vertical lines
+static uint8_t S2[stride][stride]; // 4KB, all lines
 
-    // first, orient the lines canonically
-    orient();
+// Only overlaps (2 lines or more) are counted, so the counts stop at 2 instead of wrapping at 256
+static inline void cover(uint8_t& count) {
+    if (count < 2)
+        ++count;
+}
 
-    // process sectors of size 64x64
-    int16_t res = 0, res2 = 0;
-    constexpr int16_t range = 1024;
-    constexpr int8_t stride = 64;
-    uint8_t S1[stride][stride] = {{}}; // 4KB
-    uint8_t S2[stride][stride] = {{}}; // 4KB
-    uint8_t i = 0, j = 0;
+// A line clipped to a tile, in tile coordinates: len + 1 cells from (u, v) in direction dir
+struct Piece {
+    uint8_t u, v, len, dir;
+};
+enum { RIGHT, UP, UP_RIGHT, DOWN_RIGHT };
 
-    uint8_t t = 0;
-    for (int16_t y = 0; y < range; y += stride, ++i) {
-        const int16_t yl = y, yu = y + stride - 1;
+// The pieces are bucketed by tile on the REU (CSR: the pieces of tile t are tile_end[t-1] .. tile_end[t]-1),
+// for a block of consecutive tiles (row by row) at a time, as many as MAX_TILES and the REU allow. The
+// offsets are 16 bit, from the start of each group of GROUP tiles; a single tile with more pieces than
+// that is drawn straight from the lines.
+constexpr uint16_t MAX_TILES = 1024;
+constexpr uint8_t GROUP = 16;
+constexpr uint16_t MAX_GROUP_PIECES = 0xFFFE; // the counts stop at one more
+constexpr reu_addr_t PIECES = 0x10000; // from bank 1, byte 0 of bank 0 is the zero of memset_reu
+static uint16_t tile_end[MAX_TILES];             // 2KB, from the start of the group of the tile
+static uint32_t group_start[MAX_TILES / GROUP];  // 256 bytes
+static uint16_t tiles;               // tiles per side of the field
+static uint32_t block0;              // the block: tiles block0 .. block0+block_tiles-1,
+static uint16_t block_tiles;
+static uint16_t row0, row1;          // in the tile rows row0 .. row1
+static uint16_t reu_banks;
 
-        for (int16_t x = 0; x < range; x += stride, ++j) {
-            const int16_t xl = x, xu = x + stride - 1;
+// Adds a piece to the tile
+static void draw(const Piece& piece) {
+    const uint8_t u = piece.u, v = piece.v, len = piece.len;
+    switch (piece.dir) {
+    case RIGHT:
+        for (uint8_t i = 0; i <= len; ++i) {
+            cover(S1[v][u + i]);
+            cover(S2[v][u + i]);
+        }
+        break;
+    case UP:
+        for (uint8_t i = 0; i <= len; ++i) {
+            cover(S1[v + i][u]);
+            cover(S2[v + i][u]);
+        }
+        break;
+    case UP_RIGHT:
+        for (uint8_t i = 0; i <= len; ++i)
+            cover(S2[v + i][u + i]);
+        break;
+    default:
+        for (uint8_t i = 0; i <= len; ++i)
+            cover(S2[v - i][u + i]);
+    }
+}
 
-            tick(t & (uint8_t)7); ++t;
+// What bucket() does with the pieces of the block: count them per tile into tile_end, store them
+// on the REU, or draw them (a block of one tile)
+enum { COUNT, FILL, DRAW };
 
-            // reset sector bitmaps
-            constexpr uint16_t size = stride*stride;
-            memset_reu(0, (uintptr_t)S1, size);
-            memset_reu(0, (uintptr_t)S2, size);
-
-            // find lines that intersect the sector
-            for (int16_t k = 0; k < n_lines; ++k) {
-                const int16_t x1 = lines[k][0], y1 = lines[k][1], x2 = lines[k][2], y2 = lines[k][3];
-
-                // line is horizontal [>]
-                if (y1 == y2) {
-                    if (y1 > yu || y1 < yl || x2 < xl || x1 > xu)
-                        continue;
-                    const int16_t ul = max(xl, x1) - xl, uh = min(xu, x2) - xl;
-                    const uint8_t ii = y1 - yl;
-                    for (uint8_t u = ul; u <= uh; ++u) {
-                        ++S1[ii][u];
-                        ++S2[ii][u];
-                    }
-
-                // line is vertical [^]
-                } else if (x1 == x2) {
-                    if (x1 < xl || x1 > xu || y2 < yl || y1 > yu)
-                        continue;
-                    const int16_t vl = max(yl, y1) - yl, vh = min(yu, y2) - yl;
-                    const uint8_t jj = x1 - xl;
-                    for (uint8_t v = vl; v <= vh; ++v) {
-                        ++S1[v][jj];
-                        ++S2[v][jj];
-                    }
-
-                } else {
-                    if ((x1 < xl && x2 < xl) || (y1 < yl && y2 < yl) || (x1 > xu && x2 > xu) || (y1 > yu && y2 > yu))
-                        continue;
-
-                    // line is diagonal [/]
-                    if (y1 < y2) {
-                        if (y1 + (xl - x1) > yu || y1 + (xu - x1) < yl)
-                            continue;
-                        for (int16_t v = y1 - yl, u = x1 - xl; v <= y2 - yl; ++u, ++v) {
-                            if (u > stride || v > stride)
-                                break;
-                            if (u >= 0 && v >= 0 && u < stride && v < stride)
-                                ++S2[v][u];
-                        }
-
-                    // line is diagonal [\]
-                    }  else {
-                        if (y1 - (xl - x1) < yl || y1 - (xu - x1) > yu)
-                            continue;
-                        for (int16_t v = y1 - yl, u = x1 - xl; v >= y2 - yl; ++u, --v) {
-                            if (u > stride || v < 0)
-                                break;
-                            if (u >= 0 && v >= 0 && u < stride && v < stride)
-                                ++S2[v][u];
-                        }
-                    }
-                }
+static void bucket(const int16_t* const l, const uint8_t mode) {
+    const int16_t x1 = l[0], y1 = l[1], x2 = l[2], y2 = l[3];
+    if (max(y1, y2) < (int32_t)row0 * stride || min(y1, y2) >= (int32_t)(row1 + 1) * stride)
+        return;
+    uint8_t dir;
+    int8_t dx = 1, dy = 0;
+    if (y1 == y2)
+        dir = RIGHT;
+    else if (x1 == x2)
+        dir = UP, dx = 0, dy = 1;
+    else if (y1 < y2)
+        dir = UP_RIGHT, dy = 1;
+    else
+        dir = DOWN_RIGHT, dy = -1;
+    // walk the line tile by tile, n + 1 cells left
+    int16_t x = x1, y = y1, n = dx ? x2 - x1 : y2 - y1;
+    for (;;) {
+        const uint16_t tx = x / stride, ty = y / stride;
+        const uint8_t u = x % stride, v = y % stride;
+        int16_t len = n;
+        if (dx)
+            len = min(len, stride - 1 - u);
+        if (dy > 0)
+            len = min(len, stride - 1 - v);
+        else if (dy < 0)
+            len = min(len, v);
+        const uint32_t tile = (uint32_t)ty * tiles + tx - block0; // wraps around before the block
+        if (ty >= row0 && ty <= row1 && tile < block_tiles) {
+            Piece piece = {u, v, (uint8_t)len, dir};
+            if (mode == COUNT) {
+                if (tile_end[tile] <= MAX_GROUP_PIECES)
+                    ++tile_end[tile];
+            } else if (mode == FILL) {
+                const uint32_t k = group_start[tile / GROUP] + tile_end[tile]++;
+                reucpy(&piece, PIECES + (reu_addr_t)k * sizeof(Piece), sizeof(Piece), RAM2REU);
+            } else {
+                draw(piece);
             }
-            for (uint8_t u = 0; u < stride; ++u) {
-                for (uint8_t v = 0; v < stride; ++ v) {
-                    if (S1[u][v] > 1)
-                        ++res;
-                    if (S2[u][v] > 1)
-                        ++res2;
-                }
+        }
+        if (len == n)
+            break;
+        x += dx * (len + 1);
+        y += dy * (len + 1);
+        n -= len + 1;
+    }
+}
+
+// Adds the pieces first .. last-1 of the block on the REU to the tile
+static void rasterize(uint32_t first, const uint32_t last) {
+    constexpr uint8_t BUFFER = 32;
+    Piece buffer[BUFFER];
+    while (first < last) {
+        const uint8_t n = last - first < BUFFER ? last - first : BUFFER;
+        reucpy(buffer, PIECES + (reu_addr_t)first * sizeof(Piece), n * sizeof(Piece), REU2RAM);
+        first += n;
+        for (uint8_t k = 0; k < n; ++k)
+            draw(buffer[k]);
+    }
+}
+
+// Clears the counts of the tile
+static void clear_tile() {
+    constexpr uint16_t size = stride*stride;
+    memset_reu(0, (uintptr_t)S1, size);
+    memset_reu(0, (uintptr_t)S2, size);
+}
+
+// Adds the overlaps of the tile to res (horizontal and vertical lines) and res2 (all lines)
+static void count_tile(uint32_t& res, uint32_t& res2) {
+    for (uint8_t u = 0; u < stride; ++u) {
+        for (uint8_t v = 0; v < stride; ++ v) {
+            if (S1[u][v] > 1)
+                ++res;
+            if (S2[u][v] > 1)
+                ++res2;
+        }
+    }
+}
+
+AOC64_BUDGET(C64_DATA_RAM, REU_512K, decltype(lines), decltype(S1), decltype(S2), decltype(tile_end), decltype(group_start),
+             decltype(segments), decltype(n_segments), decltype(tiles), decltype(block0), decltype(block_tiles),
+             decltype(row0), decltype(row1), decltype(reu_banks), Region<sizeof(Piece[32]), PIECES + 0x60000>);
+
+#ifndef __mos6502__
+// with --sweep, the host counts the overlaps with the sweep line of sweep.h instead of the tiles,
+// without a grid and for 32 bit coordinates
+static bool sweep = false;
+
+void solve_sweep() {
+    int32_t (*wide)[4];
+    size_t n;
+    if (!input_numbers(wide, n)) {
+        static int32_t widened[sizeof(lines) / sizeof(lines[0])][4];
+        for (size_t k = 0; k < n_lines; ++k)
+            for (uint8_t c = 0; c < 4; ++c)
+                widened[k][c] = lines[k][c];
+        wide = widened;
+        n = n_lines;
+    }
+    phase("parts");
+    const std::pair<uint64_t, uint64_t> overlaps = sweep_overlaps(wide, n);
+    printf("part 1: %llu\n", (unsigned long long)overlaps.first);
+    printf("part 2: %llu\n", (unsigned long long)overlaps.second);
+}
+#endif
+
+void solve() {
+#ifndef __mos6502__
+    if (sweep) {
+        solve_sweep();
+        return;
+    }
+#endif
+    input_numbers(segments, n_segments);
+
+    // first, orient the lines canonically, and size the field
+    int16_t range = 0;
+    {
+        AOC64_PHASE("parse");
+        orient();
+        for (size_t k = 0; k < n_segments; ++k)
+            for (uint8_t c = 0; c < 4; ++c) {
+                assert(segments[k][c] >= 0);
+                range = max(range, segments[k][c]);
+            }
+    }
+    tiles = range / stride + 1;
+    const uint32_t n_tiles = (uint32_t)tiles * tiles;
+    const uint32_t max_pieces = (uint32_t)(reu_banks - 1) * 0x10000 / sizeof(Piece);
+
+    // process the tiles of 64x64 cells, a block of tiles at a time
+    phase("parts");
+    uint32_t res = 0, res2 = 0;
+    uint8_t t = 0;
+    block_tiles = MAX_TILES;
+    for (block0 = 0; block0 < n_tiles;) {
+        if (block_tiles > n_tiles - block0)
+            block_tiles = n_tiles - block0;
+
+        // bucket the lines: count the pieces of each tile, then store them at their offsets,
+        // with half the tiles if they don't fit on the REU or a group in the offsets
+        uint32_t total;
+        bool fits;
+        for (;;) {
+            row0 = block0 / tiles;
+            row1 = (block0 + block_tiles - 1) / tiles;
+            memset(tile_end, 0, block_tiles * sizeof(tile_end[0]));
+            for (size_t k = 0; k < n_segments; ++k)
+                bucket(segments[k], COUNT);
+            total = 0;
+            fits = true;
+            for (uint16_t i = 0; i < block_tiles; ++i) {
+                if (i % GROUP == 0)
+                    group_start[i / GROUP] = total;
+                const uint16_t count = tile_end[i];
+                tile_end[i] = total - group_start[i / GROUP];
+                total += count;
+                fits &= total - group_start[i / GROUP] <= MAX_GROUP_PIECES;
+            }
+            fits &= total <= max_pieces;
+            if (fits || block_tiles == 1)
+                break;
+            block_tiles /= 2;
+        }
+        if (!fits) {
+            // a tile of too many pieces for the REU or the offsets
+            tick(t & (uint8_t)7); ++t;
+            clear_tile();
+            for (size_t k = 0; k < n_segments; ++k)
+                bucket(segments[k], DRAW);
+            count_tile(res, res2);
+        } else {
+            for (size_t k = 0; k < n_segments; ++k)
+                bucket(segments[k], FILL);
+
+            // rasterize the pieces of each tile
+            uint32_t first = 0;
+            for (uint16_t i = 0; i < block_tiles; ++i) {
+                const uint32_t last = group_start[i / GROUP] + tile_end[i];
+                if (first == last)
+                    continue;
+                tick(t & (uint8_t)7); ++t;
+                clear_tile();
+                rasterize(first, last);
+                first = last;
+                count_tile(res, res2);
             }
         }
+        // the next block may be larger again, when this one was less than half full
+        block0 += block_tiles;
+        if (total <= max_pieces / 2 && block_tiles <= MAX_TILES / 2)
+            block_tiles *= 2;
     }
 
-    printf("part 1: %u\n", res);
-    printf("part 2: %u\n", res2);
+    printf("part 1: %lu\n", res);
+    printf("part 2: %lu\n", res2);
+}
 
+int main(int argc, char** argv) {
+    init(5);
+    reu_banks = reu_init();
+    reuset(0, 0, 1);
+#ifndef __mos6502__
+    if (argc > 1 && strcmp(argv[1], "--sweep") == 0) {
+        sweep = true;
+        argv[1] = argv[0];
+        --argc, ++argv;
+    }
+#endif
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,185 @@
+#ifndef __SWEEP_H__
+#define __SWEEP_H__
+
+// Host engine for day 5 (--sweep): counts the cells covered at least twice without a grid.
+// The lines of each direction (a family) are merged along their line into the runs of cells
+// covered at least once and at least twice. A cell is then covered twice either within a
+// family (counted from its runs), or by two families, where their runs cross. The crossings of
+// each pair of families come from a sweep over the runs in coordinates that make one family
+// horizontal and the other vertical. Coordinates are 32 bit, the time O((n + k) log n) for n
+// lines and k crossings.
+#include <stdint.h>
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+// A run of cells along the line key of a family, from cell lo to cell hi
+struct Run {
+    int64_t key, lo, hi;
+};
+inline bool operator<(const Run& a, const Run& b) { return a.key < b.key || (a.key == b.key && a.lo < b.lo); }
+
+// The lines of one direction: horizontal (key y, cell x), vertical (key x, cell y),
+// up right (key x - y, cell x) and down right (key x + y, cell x)
+struct Family {
+    enum { HORIZONTAL, VERTICAL, UP_RIGHT, DOWN_RIGHT, COUNT };
+    std::vector<Run> lines;   // as given
+    std::vector<Run> covered; // merged runs of the cells covered at least once
+    std::vector<Run> twice;   // merged runs of the cells covered at least twice
+    uint64_t n_twice = 0;     // number of cells in twice
+
+    // Fills covered and twice from lines
+    void merge() {
+        std::vector<std::pair<Run, int8_t>> events; // (key, cell) where the coverage changes
+        events.reserve(2 * lines.size());
+        for (const Run& r : lines) {
+            events.push_back({{r.key, r.lo, 0}, 1});
+            events.push_back({{r.key, r.hi + 1, 0}, -1});
+        }
+        std::sort(events.begin(), events.end(),
+                  [](const std::pair<Run, int8_t>& a, const std::pair<Run, int8_t>& b) { return a.first < b.first; });
+        uint32_t count = 0;
+        for (size_t i = 0; i < events.size(); ++i) {
+            count += events[i].second;
+            // cells up to the next event on the same line have the current coverage
+            if (count == 0 || i + 1 == events.size() || events[i + 1].first.key != events[i].first.key)
+                continue;
+            const Run r = {events[i].first.key, events[i].first.lo, events[i + 1].first.lo - 1};
+            if (r.hi < r.lo)
+                continue;
+            append(covered, r);
+            if (count > 1) {
+                append(twice, r);
+                n_twice += r.hi - r.lo + 1;
+            }
+        }
+    }
+    // Whether the cell of line key is covered at least twice
+    bool in_twice(const int64_t key, const int64_t cell) const {
+        auto i = std::upper_bound(twice.begin(), twice.end(), Run {key, cell, 0});
+        return i != twice.begin() && (--i)->key == key && i->hi >= cell;
+    }
+
+    static void append(std::vector<Run>& runs, const Run& r) {
+        if (!runs.empty() && runs.back().key == r.key && runs.back().hi + 1 == r.lo)
+            runs.back().hi = r.hi;
+        else
+            runs.push_back(r);
+    }
+};
+
+// Reports (s, t) for each crossing of the horizontal runs (key t, cells s) and the vertical runs (key s, cells t)
+template <typename F>
+void sweep_crossings(const std::vector<Run>& horizontal, const std::vector<Run>& vertical, F emit) {
+    // events along s: horizontal runs start (0) before the vertical runs are queried (1), and end after them (2)
+    struct Event {
+        int64_t s;
+        uint8_t type;
+        const Run* run;
+        bool operator<(const Event& o) const { return s < o.s || (s == o.s && type < o.type); }
+    };
+    std::vector<Event> events;
+    events.reserve(2 * horizontal.size() + vertical.size());
+    for (const Run& r : horizontal) {
+        events.push_back({r.lo, 0, &r});
+        events.push_back({r.hi, 2, &r});
+    }
+    for (const Run& r : vertical)
+        events.push_back({r.key, 1, &r});
+    std::sort(events.begin(), events.end());
+    // the runs of a family never overlap on their line, so there is one active run per t at most
+    std::set<int64_t> active;
+    for (const Event& e : events) {
+        if (e.type == 0)
+            active.insert(e.run->key);
+        else if (e.type == 2)
+            active.erase(e.run->key);
+        else
+            for (auto t = active.lower_bound(e.run->lo); t != active.end() && *t <= e.run->hi; ++t)
+                emit(e.s, *t);
+    }
+}
+
+// The runs mapped to other coordinates
+template <typename F>
+std::vector<Run> map_runs(const std::vector<Run>& runs, F f) {
+    std::vector<Run> mapped;
+    mapped.reserve(runs.size());
+    for (const Run& r : runs)
+        mapped.push_back(f(r));
+    return mapped;
+}
+
+// Counts the cells covered at least twice by the horizontal and vertical lines (part 1) and by all lines (part 2)
+std::pair<uint64_t, uint64_t> sweep_overlaps(const int32_t (*const lines)[4], const size_t n) {
+    Family families[Family::COUNT];
+    for (size_t i = 0; i < n; ++i) {
+        int64_t x1 = lines[i][0], y1 = lines[i][1], x2 = lines[i][2], y2 = lines[i][3];
+        if (x1 > x2 || (x1 == x2 && y1 > y2)) {
+            std::swap(x1, x2);
+            std::swap(y1, y2);
+        }
+        if (y1 == y2)
+            families[Family::HORIZONTAL].lines.push_back({y1, x1, x2});
+        else if (x1 == x2)
+            families[Family::VERTICAL].lines.push_back({x1, y1, y2});
+        else if (y1 < y2)
+            families[Family::UP_RIGHT].lines.push_back({x1 - y1, x1, x2});
+        else
+            families[Family::DOWN_RIGHT].lines.push_back({x1 + y1, x1, x2});
+    }
+    for (Family& f : families)
+        f.merge();
+    const Family &h = families[Family::HORIZONTAL], &v = families[Family::VERTICAL];
+    const Family &u = families[Family::UP_RIGHT], &d = families[Family::DOWN_RIGHT];
+
+    // cells where two families cross, those of horizontal and vertical lines first
+    std::vector<std::pair<int64_t, int64_t>> crossings;
+    auto same = [](const Run& r) { return r; };
+    sweep_crossings(h.covered, v.covered, [&](int64_t s, int64_t t) { crossings.push_back({s, t}); });
+    const size_t n_crossings_hv = crossings.size();
+    // horizontal and up right: s = x - y, t = y
+    sweep_crossings(map_runs(h.covered, [](const Run& r) { return Run {r.key, r.lo - r.key, r.hi - r.key}; }),
+                    map_runs(u.covered, [](const Run& r) { return Run {r.key, r.lo - r.key, r.hi - r.key}; }),
+                    [&](int64_t s, int64_t t) { crossings.push_back({s + t, t}); });
+    // horizontal and down right: s = x + y, t = y
+    sweep_crossings(map_runs(h.covered, [](const Run& r) { return Run {r.key, r.lo + r.key, r.hi + r.key}; }),
+                    map_runs(d.covered, [](const Run& r) { return Run {r.key, r.key - r.hi, r.key - r.lo}; }),
+                    [&](int64_t s, int64_t t) { crossings.push_back({s - t, t}); });
+    // up right and vertical: s = x, t = x - y
+    sweep_crossings(map_runs(u.covered, same),
+                    map_runs(v.covered, [](const Run& r) { return Run {r.key, r.key - r.hi, r.key - r.lo}; }),
+                    [&](int64_t s, int64_t t) { crossings.push_back({s, s - t}); });
+    // down right and vertical: s = x, t = x + y
+    sweep_crossings(map_runs(d.covered, same),
+                    map_runs(v.covered, [](const Run& r) { return Run {r.key, r.key + r.lo, r.key + r.hi}; }),
+                    [&](int64_t s, int64_t t) { crossings.push_back({s, t - s}); });
+    // down right and up right: s = x - y, t = x + y, only where both are even or odd
+    sweep_crossings(map_runs(d.covered, [](const Run& r) { return Run {r.key, 2 * r.lo - r.key, 2 * r.hi - r.key}; }),
+                    map_runs(u.covered, [](const Run& r) { return Run {r.key, 2 * r.lo - r.key, 2 * r.hi - r.key}; }),
+                    [&](int64_t s, int64_t t) {
+                        if (((s + t) & 1) == 0)
+                            crossings.push_back({(s + t) / 2, (t - s) / 2});
+                    });
+
+    // the cells covered twice within a family, plus the crossings not among them
+    auto count = [&](std::vector<std::pair<int64_t, int64_t>> cells, const uint8_t n_families) {
+        std::sort(cells.begin(), cells.end());
+        cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+        uint64_t total = cells.size();
+        for (uint8_t f = 0; f < n_families; ++f)
+            total += families[f].n_twice;
+        for (const std::pair<int64_t, int64_t>& c : cells) {
+            const int64_t x = c.first, y = c.second;
+            total -= h.in_twice(y, x) + v.in_twice(x, y);
+            if (n_families > Family::VERTICAL + 1)
+                total -= u.in_twice(x - y, x) + d.in_twice(x + y, x);
+        }
+        return total;
+    };
+    const uint64_t part1 = count({crossings.begin(), crossings.begin() + n_crossings_hv}, Family::VERTICAL + 1);
+    return {part1, count(std::move(crossings), Family::COUNT)};
+}
+
+#endif // __SWEEP_H__
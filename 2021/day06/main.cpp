@@ -1,14 +1,21 @@
 #define NDEBUG
 
+#include <assert.h>
 #include <stdio.h>
 #include <string.h>
 #include "AoC64.h"
 #include "reucpy.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
+#include "options.h"
+#ifndef __mos6502__
+  #include "linrec.h"
+#endif
 
 void evolve(uint64_t timers[]) {
     static uint64_t old_timers[9];
@@ -30,22 +37,105 @@ uint64_t lanternfish(uint64_t timers[]) {
 }
 
 
-int main(void) {
-    init(6);
+// the fish per timer, of the compiled-in timers or counted from the timers of AOC64_INPUT on the host
+static uint64_t fish[9];
+
+void count_fish() {
+    memcpy(fish, timers, sizeof(fish));
+    const uint8_t* ages;
+    size_t n;
+    if (!input_numbers(ages, n))
+        return;
+    memset(fish, 0, sizeof(fish));
+    for (size_t i = 0; i < n; ++i) {
+        assert(ages[i] < 9);
+        ++fish[ages[i]];
+    }
+}
+
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(timers), decltype(fish), uint64_t[9]);
+
+#ifndef __mos6502__
+// with --days n, the host prints the number of fish after n days instead, from the powers of the
+// day's matrix (linrec.h): exact up to 16384 bits (about 130000 days), or modulo p (< 2^32) with --mod p
+static unsigned long long days = 0, mod = 0;
+
+template <typename T>
+T fish_after(const uint64_t n) {
+    // a day: the timers count down, those at 0 go back to 6 and spawn a fish at 8
+    static Matrix<T, 9> m;
+    for (uint8_t i = 0; i < 9; ++i)
+        for (uint8_t j = 0; j < 9; ++j)
+            m.a[i][j] = T(j == i + 1 || (j == 0 && (i == 6 || i == 8)) ? 1 : 0);
+    static T v[9];
+    for (uint8_t i = 0; i < 9; ++i)
+        v[i] = T(fish[i]);
+    advance(m, n, v);
+    T total = T(0);
+    for (uint8_t i = 0; i < 9; ++i)
+        total += v[i];
+    return total;
+}
+
+void solve_days() {
+    phase("days");
+    if (mod) {
+        ModInt::p = mod;
+        printf("days %llu mod %llu: %lu\n", days, mod, (unsigned long)fish_after<ModInt>(days).v);
+        return;
+    }
+    typedef BigUInt<512> Count;
+    static Count total;
+    total = fish_after<Count>(days);
+    if (total.overflow) {
+        printf("days %llu: more than %d bits, use --mod p\n", days, 32 * 512);
+        return;
+    }
+    printf("days %llu: ", days);
+    total.print();
+    printf("\n");
+}
+#endif
+
+void solve() {
+    count_fish();
+#ifndef __mos6502__
+    if (days > 0) {
+        solve_days();
+        return;
+    }
+#endif
+    phase("part 1");
 
     for (uint8_t i = 0; i < 80; ++i) {
-        evolve(timers);
+        evolve(fish);
         tick((i >> 3) & 7);
 
     }
-    printf("part 1: %llu\n", (unsigned long long)lanternfish(timers));
+    printf("part 1: %llu\n", (unsigned long long)lanternfish(fish));
 
+    phase("part 2");
     for (uint8_t i = 0; i < 256-80; ++i) {
-        evolve(timers);
+        evolve(fish);
         tick((i >> 3) & 7);
     }
-    printf("part 2: %llu\n", (unsigned long long)lanternfish(timers));
+    printf("part 2: %llu\n", (unsigned long long)lanternfish(fish));
+}
 
+int main(int argc, char** argv) {
+    int skip = 0;
+#ifndef __mos6502__
+    const Option options[] = {{"--days", 1, UINT64_MAX, &days}, {"--mod", 2, UINT32_MAX, &mod}};
+    skip = parse_options(argc, argv, options);
+    if (skip < 0 || (mod && days == 0)) {
+        fprintf(stderr, "usage: %s [--days n [--mod p (2 .. 2^32-1)]] [input ... | -]\n", argv[0]);
+        return 2;
+    }
+#endif
+    init(6);
+    // the inputs of a batch follow the options
+    if (!batch(argc - skip, argv + skip, solve))
+        solve();
     finish();
     return 0;
 }
\ No newline at end of file
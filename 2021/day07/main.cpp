@@ -1,7 +1,10 @@
 #include <stdio.h>
 #include <string.h>
 #include "AoC64.h"
-#if __has_include("input.h")
+#include "select.h"
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
@@ -9,30 +12,42 @@
 
 inline int32_t min(const int32_t a, const int32_t b) { return a > b ? b : a; }
 
-int main(void) {
-    init(7);
+// counts of the positions for the median, one pass for a range of up to 2048
+static uint16_t counts[2048];
+
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(crabs), decltype(counts));
 
-    // part 1
-    int32_t res1 = 1000000, m1 = 0;
-    for (int16_t c = 0; c < n_crabs; ++ c) {
-        tick(c & (uint8_t)7);
-        int32_t fuel = 0;
-        const int16_t pos = crabs[c];
+// solves the compiled-in positions, or those of AOC64_INPUT (or of each input of a batch) on the host
+void solve() {
+    const int16_t* positions = crabs;
+    int16_t n = n_crabs;
+    input_numbers(positions, n);
+
+    // part 1: the fuel is the least at the median
+    phase("part 1");
+    int32_t m1 = 0;
+    int16_t lo = positions[0], hi = positions[0];
+    for (int16_t c = 0; c < n; ++c) {
+        const int16_t pos = positions[c];
         m1 += pos;
-        for (int16_t j = 0; j < n_crabs; ++j) {
-            fuel += crabs[j] > pos ? crabs[j] - pos : pos - crabs[j];
-        }
-        if (fuel < res1)
-            res1 = fuel;
+        if (pos < lo)
+            lo = pos;
+        if (pos > hi)
+            hi = pos;
     }
+    const int16_t median = select_counting(positions, n, n / 2, lo, hi, counts);
+    int32_t res1 = 0;
+    for (int16_t c = 0; c < n; ++c)
+        res1 += positions[c] > median ? positions[c] - median : median - positions[c];
 
     // part 2
+    phase("part 2");
     int32_t res21 = 0, res22 = 0;
-    m1 = m1 / n_crabs;
+    m1 = m1 / n;
     uint32_t m2 = m1 + 1;
-    for (int16_t i = 0; i < n_crabs; ++i) {
-        int32_t d1 = crabs[i] - m1;
-        int32_t d2 = crabs[i] - m2;
+    for (int16_t i = 0; i < n; ++i) {
+        int32_t d1 = positions[i] - m1;
+        int32_t d2 = positions[i] - m2;
         if (d1 < 0)
             d1 = -d1;
         if (d2 < 0)
@@ -43,6 +58,12 @@ int main(void) {
 
     printf("part 1: %ld\n", res1);
     printf("part 2: %ld\n", min(res21, res22) / 2);
+}
 
+int main(int argc, char** argv) {
+    init(7);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
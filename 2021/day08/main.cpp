@@ -1,12 +1,18 @@
 #include <stdio.h>
 #include <string.h>
 #include "AoC64.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
 
+// the compiled-in displays, or those of AOC64_INPUT on the host (see solve)
+static const char* const* displays = lines;
+static size_t n_displays = n_lines;
+
 inline int8_t is_simple(const uint8_t len) {
     return len == 2 || len == 3 || len == 4 || len == 7;
 }
@@ -95,14 +101,18 @@ uint16_t decode(const char* line) {
     return res;
 }
 
-int main(void) {
-    init(8);
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(lines), decltype(displays), decltype(n_displays), uint8_t[10], const char*[16],
+             char[2]);
+
+void solve() {
+    input_lines(displays, n_displays);
 
     // part 1
+    phase("part 1");
     int16_t res1 = 0;
-    for (uint8_t i = 0; i < n_lines; ++i) {
+    for (size_t i = 0; i < n_displays; ++i) {
         tick((i >> 3) & 7);
-        const char* p1 = strchr(lines[i], '|') + 2, *p2;
+        const char* p1 = strchr(displays[i], '|') + 2, *p2;
         const char* pe = strchr(p1, 0);
         do {
             p2 = strchr(p1, ' ');
@@ -114,12 +124,19 @@ int main(void) {
     printf("part 1: %d\n", res1);
 
     // part 2
+    phase("part 2");
     int32_t res2 = 0;
-    for (uint8_t i = 0; i < n_lines; ++i) {
+    for (size_t i = 0; i < n_displays; ++i) {
         tick((i >> 2) & 7);
-        res2 += decode(lines[i]);
+        res2 += decode(displays[i]);
     }
     printf("part 2: %ld\n", res2);
+}
 
+int main(int argc, char** argv) {
+    init(8);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
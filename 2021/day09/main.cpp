@@ -1,77 +1,191 @@
+#include <assert.h>
 #include <stdio.h>
 #include <string.h>
 #include "AoC64.h"
-#include "queue.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
 
-struct Point {
-    int8_t y;
-    int8_t x;
+// widest heightmap: the puzzle's 100 on the C64, generated ones on the host
+#ifdef __mos6502__
+constexpr uint16_t MAX_WIDTH = 128;
+#else
+constexpr uint16_t MAX_WIDTH = 16384;
+#endif
+// basins alive at once: those of the row above and the new ones of the current row
+constexpr uint16_t MAX_LABELS = MAX_WIDTH + 2;
 
-    const Point up()    const { return Point {.y = (int8_t)(y-1), .x = x}; }
-    const Point down()  const { return Point {.y = (int8_t)(y+1), .x = x}; }
-    const Point left()  const { return Point {.y = y, .x = (int8_t)(x-1)}; }
-    const Point right() const { return Point {.y = y, .x = (int8_t)(x+1)}; }
-};
+// The heightmap is streamed: only the row, the one above and the one below (read ahead for the
+// low points) are kept, copied from the compiled-in heightmap or read one line at a time from
+// AOC64_INPUT (or from each input of a batch) on the host, so the working set is O(width).
+static char window[3][MAX_WIDTH + 1];
+static bool from_file;
+static int16_t next_row_index;  // of the compiled-in heightmap
 
-// global vars for flood fill
-constexpr uint16_t MAX_SIZE = 255;
-Queue<Point, uint8_t, MAX_SIZE> front;
-static int8_t visited[dimy][dimx] = {{}};
+// Copies the next row of the heightmap into row, false after the last one
+static bool next_row(char* const row) {
+    const char* line;
+    size_t len;
+    if (from_file) {
+        if (!input_next_line(line, len))
+            return false;
+    } else {
+        if (next_row_index == dimy)
+            return false;
+        line = heightmap[next_row_index++];
+        len = strlen(line);
+    }
+    assert(len <= MAX_WIDTH);
+    memcpy(row, line, len);
+    row[len] = 0;
+    return true;
+}
 
+// Basins are labelled row by row (scanline connected components): a cell takes the label of its
+// neighbour above or to the left, and labels that meet are merged (union-find). Only two rows of
+// labels are kept; a basin is complete once none of its cells is in the last row, then its label
+// is recycled. Label 0 is a 9.
+typedef uint16_t Label;
+static Label above[MAX_WIDTH], current[MAX_WIDTH];
+static struct Basins {
+    Label parent[MAX_LABELS];   // 0 when the label is free
+    uint32_t size[MAX_LABELS];  // of the roots
+    uint8_t low[MAX_LABELS];    // the basin (root) has a low point
+    uint16_t seen[MAX_LABELS];  // row of the last cell of the basin (root)
+    Label unused[MAX_LABELS];   // stack of the free labels
+    uint16_t n_unused;
+    Label top;                  // highest label used so far
 
-inline void explore(const Point p) {
-    if (p.y < 0 || p.x < 0 || p.y >= dimy || p.x >= dimx || heightmap[p.y][p.x] == '9' || visited[p.y][p.x])
-        return;
-    visited[p.y][p.x] = 1;
-    front.push(p);
-}
+    void clear() {
+        memset(parent, 0, sizeof(parent));
+        n_unused = 0;
+        for (Label l = MAX_LABELS - 1; l > 0; --l)
+            unused[n_unused++] = l;
+        top = 0;
+    }
+    Label add() {
+        assert(n_unused > 0);
+        const Label l = unused[--n_unused];
+        if (l > top)
+            top = l;
+        parent[l] = l;
+        size[l] = 0;
+        low[l] = 0;
+        seen[l] = 0;
+        return l;
+    }
+    void remove(const Label l) {
+        parent[l] = 0;
+        unused[n_unused++] = l;
+    }
+    Label find(Label l) {
+        while (parent[l] != l)
+            l = parent[l] = parent[parent[l]];
+        return l;
+    }
+    // merges the basins of a and b, returns the root
+    Label merge(Label a, Label b) {
+        a = find(a), b = find(b);
+        if (a == b)
+            return a;
+        if (size[a] < size[b]) {
+            const Label t = a; a = b; b = t;
+        }
+        parent[b] = a;
+        size[a] += size[b];
+        low[a] |= low[b];
+        return a;
+    }
+} basins;
+
+static int32_t top3[3];
 
-int16_t flood_fill(const Point p0) {
-    int16_t count = 0;
-    front.push(p0);
-    visited[p0.y][p0.x] = 1;
-    while (front.size()) {
-        const Point p = front.pop();
-        ++count;
-        explore(p.up()); explore(p.down()); explore(p.left()); explore(p.right());
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(heightmap), decltype(window), decltype(from_file), decltype(next_row_index),
+             decltype(above), decltype(current), decltype(basins), decltype(top3));
+
+static void add_basin(const int32_t basin) {
+    if (basin > top3[0]) {
+        top3[2] = top3[1]; top3[1] = top3[0]; top3[0] = basin;
+    } else if (basin > top3[1]) {
+        top3[2] = top3[1]; top3[1] = basin;
+    } else if (basin > top3[2]) {
+        top3[2] = basin;
     }
-    return count;
 }
 
-int main(void) {
-    init(9);
+void solve() {
+    from_file = input_stream();
+    next_row_index = 0;
+    const char* up_row = nullptr;  // none above the first row
+    char* row = window[0];
+    char* down_row = window[1];
+    bool has_row = next_row(row);
+    bool has_down = has_row && next_row(down_row);
+    const int16_t width = strlen(row);
 
-    int16_t risk = 0;
-    int32_t top3[3] = {};
-    for (int8_t i = 0; i < dimy; ++i) {
-        tick(i  & 7);
-        for (int8_t j = 0; j < dimx; ++j) {
-            const char h = heightmap[i][j];
-            if ((i == 0        || heightmap[i-1][j] > h) &&
-                (i == dimy - 1 || heightmap[i+1][j] > h) &&
-                (j == 0        || heightmap[i][j-1] > h) &&
-                (j == dimx - 1 || heightmap[i][j+1] > h)) {
-                    risk += h - '0' + 1;
-                    if (!visited[i][j]) {
-                        const int16_t basin = flood_fill(Point {.y=i, .x=j});
-                        if (basin > top3[0]) {
-                            top3[2] = top3[1]; top3[1] = top3[0]; top3[0] = basin;
-                        } else if (basin > top3[1]) {
-                            top3[2] = top3[1]; top3[1] = basin;
-                        } else if (basin > top3[2]) {
-                            top3[2] = basin;
-                        }
-                    }
-                }
+    int32_t risk = 0;
+    top3[0] = top3[1] = top3[2] = 0;
+    basins.clear();
+    memset(above, 0, sizeof(above));
+    for (uint16_t i = 0; has_row; ++i) {
+        tick(i & 7);
+        assert((int16_t)strlen(row) == width);
+        for (int16_t j = 0; j < width; ++j) {
+            const char h = row[j];
+            if (h == '9') {
+                current[j] = 0;
+                continue;
+            }
+            const Label up = above[j], left = j ? current[j - 1] : 0;
+            const Label l = basins.find(up && left ? basins.merge(up, left) : up ? up : left ? left : basins.add());
+            current[j] = l;
+            ++basins.size[l];
+            if ((up_row == nullptr || up_row[j] > h) &&
+                (!has_down         || down_row[j] > h) &&
+                (j == 0            || row[j-1] > h) &&
+                (j == width - 1    || row[j+1] > h)) {
+                risk += h - '0' + 1;
+                basins.low[l] = 1;
+            }
         }
+        // the row only refers to roots from now on, the other labels are free
+        const uint16_t stamp = i + 1;
+        for (int16_t j = 0; j < width; ++j)
+            if (current[j])
+                basins.seen[current[j] = basins.find(current[j])] = stamp;
+        for (Label l = 1; l <= basins.top; ++l) {
+            if (basins.parent[l] == 0 || (basins.parent[l] == l && basins.seen[l] == stamp))
+                continue;
+            // a basin without cells in this row is complete, it counts if it has a low point
+            if (basins.parent[l] == l && basins.low[l])
+                add_basin(basins.size[l]);
+            basins.remove(l);
+        }
+        memcpy(above, current, width * sizeof(Label));
+        // the window moves down a row, the buffer of the row above is reused for the next one
+        char* const spare = up_row ? (char*)up_row : window[2];
+        up_row = row;
+        row = down_row;
+        down_row = spare;
+        has_row = has_down;
+        has_down = has_row && next_row(down_row);
     }
-    printf("part 1: %d\n", risk);
-    printf("part 2: %ld\n", top3[0]*top3[1]*top3[2]);
+    for (Label l = 1; l <= basins.top; ++l)
+        if (basins.parent[l] == l && basins.low[l])
+            add_basin(basins.size[l]);
+
+    printf("part 1: %ld\n", risk);
+    printf("part 2: %lld\n", (int64_t)top3[0]*top3[1]*top3[2]);
+}
 
+int main(int argc, char** argv) {
+    init(9);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
@@ -1,15 +1,30 @@
+#include <assert.h>
 #include <stdio.h>
 #include <string.h>
 #include "AoC64.h"
 #include "stack.h"
-#include <stdlib.h>
-#if __has_include("input.h")
+#include "select.h"
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
 
 
+// the compiled-in lines, or those of AOC64_INPUT on the host (see solve)
+static const char* const* chunks = lines;
+static size_t n_chunks = n_lines;
+
+#ifdef __mos6502__
+constexpr uint8_t MAX_LINES = n_lines;
+#else
+constexpr uint32_t MAX_LINES = 1 << 20;
+#endif
+// the completion scores of the incomplete lines
+static int64_t scores[MAX_LINES];
+
 // global stack
 Stack<char, uint8_t, 128> stack;
 
@@ -52,34 +67,32 @@ int64_t completion_score() {
     return score;
 }
 
-int comp_i64(const void* elem1, const void* elem2)
-{
-    int64_t f = *((int64_t*)elem1);
-    int64_t s = *((int64_t*)elem2);
-    if (f > s) return  1;
-    if (f < s) return -1;
-    return 0;
-};
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(lines), decltype(chunks), decltype(n_chunks), decltype(scores), decltype(stack));
 
-int main(void) {
-    init(10);
+void solve() {
+    input_lines(chunks, n_chunks);
+    assert(n_chunks <= MAX_LINES);
 
     int32_t res1 = 0;
-    int64_t res2[n_lines] = {0};
-    int8_t ncomp = 0;
-    for (int8_t i = 0; i < n_lines; ++i) {
+    size_t ncomp = 0;
+    for (size_t i = 0; i < n_chunks; ++i) {
         tick((i >> 3) & (uint8_t)7);
-        const int16_t score = corrupted(lines[i]);
+        const int16_t score = corrupted(chunks[i]);
         if (score > 0) {
             res1 += score;
         } else {
-            res2[ncomp++] = completion_score();
+            scores[ncomp++] = completion_score();
         }
     }
-    qsort(res2, ncomp, sizeof(*res2), comp_i64);
 
     printf("part 1: %lu\n", res1);
-    printf("part 2: %lld\n", res2[ncomp / 2]);
+    printf("part 2: %lld\n", select(scores, ncomp, ncomp / 2));
+}
 
+int main(int argc, char** argv) {
+    init(10);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
@@ -4,14 +4,14 @@ constexpr int8_t dimx = 10;
 constexpr int8_t dimy = 10;
 constexpr int8_t n_octopi = dimx*dimy;
 
-char* const energy[] = {
-(char*)"5483143223",
-(char*)"2745854711",
-(char*)"5264556173",
-(char*)"6141336146",
-(char*)"6357385478",
-(char*)"4167524645",
-(char*)"2176841721",
-(char*)"6882881134",
-(char*)"4846848554",
-(char*)"5283751526"};
\ No newline at end of file
+char energy[dimy][dimx + 1] = {
+"5483143223",
+"2745854711",
+"5264556173",
+"6141336146",
+"6357385478",
+"4167524645",
+"2176841721",
+"6882881134",
+"4846848554",
+"5283751526"};
\ No newline at end of file
@@ -1,101 +1,207 @@
+#include <assert.h>
 #include <stdio.h>
 #include <string.h>
 #include "AoC64.h"
-#include "stack.h"
-#include "reucpy.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
 
-struct Point {
-    int8_t y;
-    int8_t x;
-};
+// Energy levels as bit planes: bit x % BITS of word x / BITS of row y in plane k is bit k of the level of
+// the octopus at (x, y). A level is at most 9 + 8 before the octopus flashes, so 5 planes hold it. A step
+// adds 1 to every level and the flashing neighbours to the others, a wave of flashes at a time, with
+// ripple carry adds of whole words.
+#ifdef __mos6502__
+typedef uint16_t Word; // a row of the puzzle's 10 fits in one
+#else
+typedef uint64_t Word;
+#endif
+constexpr uint8_t BITS = 8 * sizeof(Word);
+#ifdef __mos6502__
+// the puzzle's grid
+constexpr uint16_t width = dimx, height = dimy;
+constexpr uint16_t words = (dimx + BITS - 1) / BITS;
+constexpr uint16_t MAX_HEIGHT = height, MAX_WORDS = words;
+#else
+// the compiled-in grid, or that of AOC64_INPUT (see solve)
+constexpr uint16_t MAX_WIDTH = 4096, MAX_HEIGHT = 4096;
+constexpr uint16_t MAX_WORDS = MAX_WIDTH / BITS;
+static uint16_t width = dimx, height = dimy;
+static uint16_t words = (dimx + BITS - 1) / BITS;
+#endif
+constexpr uint8_t PLANES = 5;
+static Word level[PLANES][MAX_HEIGHT][MAX_WORDS];
+static Word valid[MAX_WORDS];               // the columns of the grid
+static Word flashed[MAX_HEIGHT][MAX_WORDS]; // octopi that flashed in this step
+static Word wave[MAX_HEIGHT][MAX_WORDS];    // octopi that flashed in the last wave
+static uint8_t waving[MAX_HEIGHT];          // the rows with octopi in the wave
+
+static inline uint8_t count_bits(Word w) {
+#ifdef __mos6502__
+    uint8_t n = 0;
+    for (; w; w &= w - 1)
+        ++n;
+    return n;
+#else
+    return __builtin_popcountll(w);
+#endif
+}
+
+static inline void full_add(const Word a, const Word b, const Word c, Word& sum, Word& carry) {
+    sum = a ^ b ^ c;
+    carry = (a & b) | (c & (a ^ b));
+}
 
-// global stack
-Stack<Point, uint8_t, 128> stack;
+// the levels from the energy grid, the compiled-in one without lines
+void setup(const char* const* const lines) {
+    for (uint8_t k = 0; k < PLANES; ++k)
+        for (uint16_t i = 0; i < height; ++i)
+            memset(level[k][i], 0, words * sizeof(Word));
+    memset(valid, 0, sizeof(valid));
+    for (uint16_t j = 0; j < width; ++j)
+        valid[j / BITS] |= (Word)1 << (j % BITS);
+    for (uint16_t i = 0; i < height; ++i) {
+        const char* const row = lines ? lines[i] : energy[i];
+        for (uint16_t j = 0; j < width; ++j)
+            for (uint8_t k = 0; k < PLANES; ++k)
+                if ((row[j] - '0') >> k & 1)
+                    level[k][i][j / BITS] |= (Word)1 << (j % BITS);
+    }
+}
+
+// the octopi of row i and word w at 10 or more that did not flash yet
+static inline Word ready(const uint16_t i, const uint16_t w) {
+    return (level[4][i][w] | (level[3][i][w] & (level[2][i][w] | level[1][i][w]))) & ~flashed[i][w] & valid[w];
+}
 
-// global variables for flood fill
-static int8_t flashed[dimy][dimx]; // tracking octopi that already flashed
-static int8_t marked[dimy][dimx];  // to prevent multiple instances of the same octopus on the stack
-int8_t flash() {
-    int8_t flashes = 0;
-    memset_reu(0, (uintptr_t)flashed, n_octopi);
-    memset_reu(0, (uintptr_t)marked, n_octopi);
-    static const int8_t neighbors[8][2] = {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}};
-    // first, increase energy level of all by 1
-    for (int8_t i = 0; i < dimy; ++i) {
-        for (int8_t j = 0; j < dimx; ++j) {
-            ++energy[i][j];
+int32_t flash() {
+    // first, increase energy level of all by 1, those at 10 flash first
+    bool flashing = false;
+    for (uint16_t i = 0; i < height; ++i) {
+        waving[i] = 0;
+        for (uint16_t w = 0; w < words; ++w) {
+            Word carry = valid[w];
+            for (uint8_t k = 0; k < PLANES; ++k) {
+                const Word bit = level[k][i][w];
+                level[k][i][w] = bit ^ carry;
+                carry &= bit;
+            }
+            flashed[i][w] = 0;
+            waving[i] |= (wave[i][w] = ready(i, w)) != 0;
+            flashed[i][w] = wave[i][w];
         }
+        flashing |= waving[i];
     }
-    // next, walk over the grid and find an octopus that will flash
-    for (int8_t i = 0; i < dimy; ++i) {
-        for (int8_t j = 0; j < dimx; ++j) {
-            // if an octopus can flash, push it onto the stack
-            if (energy[i][j] > '9' && !flashed[i][j]) {
-                stack.clear();
-                stack.push(Point {.y = i, .x = j});
-                // repeat while the stack is not empty
-                while (stack.size()) {
-                    const Point p = stack.pop();
-                    if (flashed[p.y][p.x])
+    // then, add the count of flashing neighbours to the others until no more flash,
+    // in the rows next to those of the wave only
+    static uint8_t touched[MAX_HEIGHT];
+    while (flashing) {
+        for (uint16_t i = 0; i < height; ++i) {
+            touched[i] = waving[i] || (i > 0 && waving[i - 1]) || (i + 1 < height && waving[i + 1]);
+            if (!touched[i])
+                continue;
+            for (uint16_t w = 0; w < words; ++w) {
+                // the 8 neighbours: the rows above and below, and all three shifted left and right
+                Word n[8];
+                uint8_t m = 0;
+                for (int8_t di = -1; di <= 1; ++di) {
+                    if ((di < 0 && i == 0) || (di > 0 && i + 1 == height)) {
+                        // no row beyond the edge
+                        n[m++] = 0, n[m++] = 0, n[m++] = 0;
                         continue;
-                    // this octopus flashes
-                    ++flashes;
-                    flashed[p.y][p.x] = 1;
-                    energy[p.y][p.x] = '0';
-                    // neighboring octopuses that have not yet flashed increase their energy by 1
-                    for (int8_t k = 0; k < 8; ++k) {
-                        const int8_t y1 = p.y + neighbors[k][0], x1 = p.x + neighbors[k][1];
-                        if (y1 < 0 || y1 >= dimy || x1 < 0 || x1 >= dimx || flashed[y1][x1] || marked[y1][x1])
-                            continue;
-                        ++energy[y1][x1];
-                        // if their new energy exceeds 9, push them onto the stack
-                        if (energy[y1][x1] > '9') {
-                            marked[y1][x1] = 1;
-                            stack.push(Point {.y = y1, .x = x1});
-                        }
                     }
+                    const Word* const row = wave[i + di];
+                    if (di)
+                        n[m++] = row[w];
+                    n[m++] = (Word)(row[w] << 1) | (w > 0 ? (Word)(row[w - 1] >> (BITS - 1)) : 0);
+                    n[m++] = (Word)(row[w] >> 1) | (w + 1 < words ? (Word)(row[w + 1] << (BITS - 1)) : 0);
+                }
+                // count them (4 bits) with carry save adders
+                Word s1, c1, s2, c2, ones, c4, t, d1, twos, d2;
+                full_add(n[0], n[1], n[2], s1, c1);
+                full_add(n[3], n[4], n[5], s2, c2);
+                const Word s3 = n[6] ^ n[7], c3 = n[6] & n[7];
+                full_add(s1, s2, s3, ones, c4);
+                full_add(c1, c2, c3, t, d1);
+                twos = t ^ c4, d2 = t & c4;
+                const Word count[4] = {ones, twos, d1 ^ d2, d1 & d2};
+                // and add them to the octopi that did not flash yet
+                const Word mask = ~flashed[i][w] & valid[w];
+                Word carry = 0;
+                for (uint8_t k = 0; k < PLANES; ++k) {
+                    const Word add = k < 4 ? count[k] & mask : 0, bit = level[k][i][w];
+                    level[k][i][w] = bit ^ add ^ carry;
+                    carry = (bit & add) | (carry & (bit ^ add));
                 }
             }
         }
+        flashing = false;
+        for (uint16_t i = 0; i < height; ++i) {
+            if (!touched[i])
+                continue;
+            waving[i] = 0;
+            for (uint16_t w = 0; w < words; ++w) {
+                waving[i] |= (wave[i][w] = ready(i, w)) != 0;
+                flashed[i][w] |= wave[i][w];
+            }
+            flashing |= waving[i];
+        }
     }
-    return flashes;
-}
-
-void display(int16_t i) {
-    printf("after step %d:\n", i);
-    for (int8_t i = 0; i < dimy; ++i) {
-        for (int8_t j = 0; j < dimx; ++j) {
-            printf("%c", energy[i][j]);
+    // the octopi that flashed are back to 0
+    int32_t flashes = 0;
+    for (uint16_t i = 0; i < height; ++i) {
+        for (uint16_t w = 0; w < words; ++w) {
+            for (uint8_t k = 0; k < PLANES; ++k)
+                level[k][i][w] &= ~flashed[i][w];
+            flashes += count_bits(flashed[i][w]);
         }
-        printf("\n");
     }
+    return flashes;
 }
 
-int main(void) {
-    init(11);
-    reuset(0, 0, 1);
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(energy), decltype(level), decltype(valid), decltype(flashed), decltype(wave),
+             decltype(waving), uint8_t[MAX_HEIGHT]);
 
-    int16_t i;
-    int16_t res = 0;
+void solve() {
+    const char* const* lines = nullptr;
+#ifndef __mos6502__
+    size_t n;
+    if (input_lines(lines, n)) {
+        width = strlen(lines[0]);
+        height = n;
+        words = (width + BITS - 1) / BITS;
+        assert(width <= MAX_WIDTH && height <= MAX_HEIGHT);
+    }
+#endif
+    setup(lines);
+
+    phase("part 1");
+    int32_t i;
+    int32_t res = 0;
     for (i = 0; i < 100; ++i) {
         tick((i >> 1) & (uint8_t)7);
         res += flash();
     }
-    printf("part 1: %d\n", res);
+    printf("part 1: %ld\n", res);
 
-    int8_t flashes;
+    phase("part 2");
+    int32_t flashes;
     do {
         tick((i >> 1) & (uint8_t)7);
         flashes = flash();
         ++i;
-    } while (flashes < n_octopi);
+    } while (flashes < (int32_t)width * height);
     //
-    printf("part 2: %d\n", i);
+    printf("part 2: %ld\n", i);
+}
 
+int main(int argc, char** argv) {
+    init(11);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
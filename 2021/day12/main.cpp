@@ -1,8 +1,11 @@
 #include <stdio.h>
 #include <string.h>
 #include "AoC64.h"
-#include "stack.h"
-#if __has_include("input.h")
+#include "hashmap.h"
+#include "pearson.h"
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
@@ -12,8 +15,7 @@ inline int8_t min(const int8_t a, const int8_t b) { return a > b ? b : a; }
 
 // memory limits for global variables on stack
 constexpr int8_t MAX_CAVES = 16;
-constexpr int8_t MAX_VISITED = 10;
-constexpr uint16_t MAX_STACK = 32;
+constexpr uint16_t MAX_PATHS = 3072;
 
 // caves
 static struct Caves {
@@ -41,100 +43,105 @@ inline int8_t is_small(const int8_t id) {
     return caves.name[id][0] >= 'a';
 }
 
-// cave graph
-static int8_t graph[MAX_CAVES][MAX_CAVES];
+// the compiled-in connections, or those of AOC64_INPUT (or of each input of a batch) on the host (see solve)
+static char* const* links = connections;
+static int8_t n_links = n_connections;
+
+// number of paths to the end from a cave, after visiting the small caves in visited,
+// with twice set once a small cave was visited twice (always for part 1)
+struct Paths {
+    uint16_t visited;
+    int8_t cave;
+    uint8_t twice;
+    const uint16_t hash() const { return hash16((const uint8_t*)this, 4); }
+};
+bool operator==(const Paths& lhs, const Paths& rhs) {
+    return lhs.visited == rhs.visited && lhs.cave == rhs.cave && lhs.twice == rhs.twice;
+}
+// memo of the counts, shared by both parts: part 2 ends in the states of part 1 after the second visit
+static HashMap<Paths, int32_t, uint16_t, MAX_PATHS> paths;
+static uint16_t n_paths;
+
+// cave graph: bit j of adjacent[i] links cave i to cave j (never back to start), small has the small caves
+static uint16_t adjacent[MAX_CAVES];
+static uint16_t small;
 static int8_t start, end;
 void setup_graph() {
+    caves.count = 0;
+    memset(adjacent, 0, sizeof(adjacent));
     char node[3] = {0};
-    for (int8_t i = 0; i < n_connections; ++i) {
-        char* split = strchr(connections[i], '-');
+    for (int8_t i = 0; i < n_links; ++i) {
+        char* split = strchr(links[i], '-');
         memset(node, 0, 3);
-        strncpy(node, connections[i], min(split - connections[i], 2));
+        strncpy(node, links[i], min(split - links[i], 2));
         const int8_t i1 = add_cave(node);
         memset(node, 0, 3);
         strncpy(node, split + 1, min(strlen(split + 1), 2));
         const int8_t i2 = add_cave(node);
-        graph[i1][i2] = 1;
-        graph[i2][i1] = 1;
+        adjacent[i1] |= (uint16_t)1 << i2;
+        adjacent[i2] |= (uint16_t)1 << i1;
     }
     start = get_cave("st");
     end = get_cave("en");
-}
-
-int8_t max_visited = -1;
-typedef struct {
-    int8_t id;
-    int8_t n_visited;
-    int8_t twice;
-    int8_t visited[MAX_VISITED];
-} State;
-
-// global stack
-
-
-inline int8_t visited(const State* const state, const int8_t id) {
-    uint8_t count = 0;
-    for (int8_t i = 0; i < state->n_visited; ++i)
-        if (state->visited[i] == id)
-            ++count;
-    return count;
-}
-
-inline void visit(State* const state, const int8_t id) {
-    state->id = id;
-    if (is_small(id)) {
-        state->visited[state->n_visited] = id;
-        state->n_visited++;
+    small = 0;
+    for (int8_t i = 0; i < caves.count; ++i) {
+        adjacent[i] &= ~((uint16_t)1 << start | (uint16_t)1 << i);
+        if (is_small(i))
+            small |= (uint16_t)1 << i;
     }
+    paths.clear();
+    n_paths = 0;
 }
 
-inline int8_t can_visit(const State* const state, const int8_t id) {
-    if (id == start || id == state->id || !graph[state->id][id]) return 0;
-    if (id == end) return 1;
-    if (is_small(id)) {
-        const int8_t visit_count = visited(state, id);
-        if (visit_count == 1 && state->twice == 0) return 2;
-        if (visit_count > 0) return 0;
+int32_t count_paths(const int8_t cave, const uint16_t visited, const uint8_t twice) {
+    if (cave == end)
+        return 1;
+    // only the small caves are memoized, a big cave adds the counts of its (small) neighbours
+    const bool memoize = (small >> cave) & 1;
+    const Paths key = {visited, cave, twice};
+    if (memoize) {
+        const int32_t* const memo = paths.get(key);
+        if (memo != nullptr)
+            return *memo;
     }
-    return 1;
-}
-
-int32_t enumerate(const int8_t part2 = 0) {
+    static uint8_t iter;
+    tick(iter++ >> 5 & 7);
     int32_t count = 0;
-    static Stack<State, uint8_t, MAX_STACK> stack;
-    stack.clear();
-    stack.push(State {.id = start, .n_visited = 0, .twice = 0, .visited = {}});
-    int8_t i = 0;
-    while (stack.size()) {
-        tick(i++ >> 5 & 7);
-        const State current = stack.pop();
-        if (current.id == end) {
-            ++count;
+    uint16_t next = adjacent[cave];
+    for (int8_t i = 0; next; ++i, next >>= 1) {
+        if (!(next & 1))
             continue;
-        }
-        for (int8_t i = 0; i < caves.count; ++i) {
-            const int8_t cave_valid = can_visit(&current, i);
-            if (part2 && cave_valid == 2) {
-                State new_state = current;
-                visit(&new_state, i);
-                new_state.twice = 1;
-                stack.push(new_state);
-            } else if (cave_valid == 1) {
-                State new_state = current;
-                visit(&new_state, i);
-                stack.push(new_state);
-            }
-        }
+        const uint16_t bit = (uint16_t)1 << i;
+        if (!(visited & bit))
+            count += count_paths(i, visited | (small & bit), twice);
+        else if (!twice)
+            count += count_paths(i, visited, 1);
+    }
+    // past 3/4 full the probes get long, the remaining states are counted again when met
+    if (memoize && n_paths < MAX_PATHS / 4 * 3) {
+        paths.insert(key, count);
+        ++n_paths;
     }
     return count;
 }
 
-int main(void) {
-    init(12);
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(connections), decltype(caves), decltype(adjacent), decltype(paths),
+             decltype(links), decltype(n_links), decltype(n_paths), decltype(small), decltype(start), decltype(end), uint8_t);
+
+void solve() {
+    input_lines(links, n_links);
 
-    setup_graph();
-    printf("part 1: %ld\n", enumerate());
-    printf("part 2: %ld\n", enumerate(1));
+    { AOC64_PHASE("parse"); setup_graph(); }
+    phase("part 1");
+    printf("part 1: %ld\n", count_paths(start, (uint16_t)1 << start, 1));
+    phase("part 2");
+    printf("part 2: %ld\n", count_paths(start, (uint16_t)1 << start, 0));
+}
 
+int main(int argc, char** argv) {
+    init(12);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
@@ -1,91 +1,150 @@
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "AoC64.h"
-#include "hashset.h"
-#include "pearson.h"
-#if !__has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
 
-constexpr int16_t MAX_SIZE = 1 << 10;  // needs to be power of 2 for MOD macro
-#define MOD(x) ((x) & (MAX_SIZE - 1))
-
+constexpr int8_t MAX_FOLDS = 32;
+#ifdef __mos6502__
+constexpr int16_t MAX_DOTS = n_dots;
+#else
+constexpr int16_t MAX_DOTS = 32767;
+#endif
 
 struct Point {
     int16_t x;
     int16_t y;
-    const uint16_t hash() const { return MOD(this->x*31 + this->y); }
 };
-bool operator==(const Point& lhs, const Point& rhs) { return lhs.x == rhs.x && lhs.y == rhs.y; }
 
-// global hash set
-// 1KB entries = 5KB memory used (4KB for data, 1KB for markers)
-HashSet<Point, int16_t, MAX_SIZE> hs;
+// The folds of each axis independently (0 for x, 1 for y), in order: a coordinate is mapped through
+// the folds of its axis only, once per point, and the points are deduplicated by sorting them when counting
+static int16_t along[2][MAX_FOLDS];
+static int8_t n_along[2];
+static int8_t first_axis;
+static Point points[MAX_DOTS];
 
-void foldx(const int16_t x) {
-    Point point;
-    for (int16_t i = 0; i < MAX_SIZE; ++i) {
-        tick((i >> 6) & (uint8_t)7);
-        if (!hs.isOccupied(i) || hs.data[i].x <= x)
-            continue;
-        point = hs.data[i];
-        hs.remove(point);
-        point.x = 2*x - point.x;
-        hs.insert(point);
+// the compiled-in dots and folds, or those of AOC64_INPUT on the host (see parse_input)
+static const int16_t (*paper)[2] = dots;
+static int16_t n_paper = n_dots;
+static const char* const* instructions = folds;
+static int8_t n_instructions = n_folds;
+
+#ifndef __mos6502__
+static int16_t file_dots[MAX_DOTS][2];
+
+// the dots (up to the empty line) and the folds of AOC64_INPUT, false if it is not set
+bool parse_input() {
+    char* const* lines;
+    size_t n;
+    if (!input_lines(lines, n))
+        return false;
+    size_t i = 0;
+    for (; i < n && *lines[i]; ++i) {
+        assert(i < MAX_DOTS);
+        char* p;
+        file_dots[i][0] = strtol(lines[i], &p, 10);
+        file_dots[i][1] = strtol(p + 1, nullptr, 10);
     }
+    paper = file_dots;
+    n_paper = i;
+    instructions = lines + i + 1;
+    n_instructions = n - i - 1;
+    return true;
 }
+#endif
 
-void foldy(const int16_t y) {
-    Point point;
-    for (int16_t i = 0; i < MAX_SIZE; ++i) {
-        tick((i >> 6) & (uint8_t)7);
-        if (!hs.isOccupied(i) || hs.data[i].y <= y)
-            continue;
-        point = hs.data[i];
-        hs.remove(point);
-        point.y = 2*y - point.y;
-        hs.insert(point);
+void parse_folds() {
+    n_along[0] = n_along[1] = 0;
+    for (int8_t i = 0; i < n_instructions; ++i) {
+        const char* eq = strchr(instructions[i], '=');
+        const int8_t axis = *(eq-1) == 'x' ? 0 : 1;
+        if (i == 0)
+            first_axis = axis;
+        assert(n_along[axis] < MAX_FOLDS);
+        along[axis][n_along[axis]++] = atoi(eq+1);
     }
 }
 
-void fold(const int8_t i) {
-    const char* eq = strchr(folds[i], '=');
-    if (*(eq-1) == 'x')
-        foldx(atoi(eq+1));
-    else
-        foldy(atoi(eq+1));
+// v folded along the folds first .. last-1 of an axis
+inline int16_t fold(int16_t v, const int16_t* const at, const int8_t first, const int8_t last) {
+    for (int8_t k = first; k < last; ++k)
+        if (v > at[k])
+            v = 2*at[k] - v;
+    return v;
 }
 
-int main(void) {
-    init(13);
+// row by row
+int compare_points(const void* elem1, const void* elem2) {
+    const Point* const a = (const Point*)elem1;
+    const Point* const b = (const Point*)elem2;
+    if (a->y != b->y)
+        return a->y < b->y ? -1 : 1;
+    return a->x < b->x ? -1 : a->x > b->x;
+}
 
-    hs.clear();
-    for (int16_t i = 0; i < n_dots; ++i) {
+// sorts the first n points and drops the duplicates, returns the number left
+int16_t unique(const int16_t n) {
+    qsort(points, n, sizeof(Point), compare_points);
+    int16_t m = 0;
+    for (int16_t i = 0; i < n; ++i)
+        if (m == 0 || compare_points(&points[m - 1], &points[i]) != 0)
+            points[m++] = points[i];
+    return m;
+}
+
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(dots), decltype(folds), decltype(along), decltype(n_along), decltype(first_axis),
+             decltype(points), decltype(paper), decltype(n_paper), decltype(instructions), decltype(n_instructions));
+
+void solve() {
+    phase("parse");
+#ifndef __mos6502__
+    parse_input();
+#endif
+    parse_folds();
+
+    // part 1: the first fold only
+    phase("part 1");
+    for (int16_t i = 0; i < n_paper; ++i) {
         tick((i >> 6) & (uint8_t)7);
-        hs.insert(*(Point *)(&dots[i]));
-    }
-    fold(0);
-    int16_t visible = 0;
-    for (int16_t i = 0; i < MAX_SIZE; ++i) {
-        if (hs.isOccupied(i))
-            ++visible;
+        points[i] = Point {.x = paper[i][0], .y = paper[i][1]};
+        int16_t& v = first_axis == 0 ? points[i].x : points[i].y;
+        v = fold(v, along[first_axis], 0, 1);
     }
+    int16_t visible = unique(n_paper);
     printf("part 1: %d\n", visible);
 
-    // part 2
-    for (int8_t i = 1; i < n_folds; ++i) {
-        fold(i);
+    // part 2: the other folds
+    phase("part 2");
+    for (int16_t i = 0; i < visible; ++i) {
+        tick((i >> 6) & (uint8_t)7);
+        points[i].x = fold(points[i].x, along[0], first_axis == 0, n_along[0]);
+        points[i].y = fold(points[i].y, along[1], first_axis == 1, n_along[1]);
     }
+    visible = unique(visible);
     printf("part 2:\n");
+    const Point* p = points;
+    const Point* const end = points + visible;
     for (int8_t i = 0; i < 6; ++i) {
         for (int8_t j = 0; j < 39; ++j) {
-            Point p = {.x = j, .y = i};
-            if (hs.find(p) != -1) printf("#"); else printf(".");
+            while (p < end && (p->y < i || (p->y == i && p->x < j)))
+                ++p;
+            if (p < end && p->y == i && p->x == j) printf("#"); else printf(".");
         }
         printf("\n");
     }
+}
 
+int main(int argc, char** argv) {
+    init(13);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
-}
\ No newline at end of file
+    return 0;
+}
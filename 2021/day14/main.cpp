@@ -1,12 +1,19 @@
+#include <assert.h>
 #include <stdio.h>
 #include <string.h>
 #include "AoC64.h"
 #include "reucpy.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
+#include "options.h"
+#ifndef __mos6502__
+  #include "matrix.h"
+#endif
 
 constexpr int8_t N_LETTERS = 26;
 static uint64_t pfreq[N_LETTERS*N_LETTERS] = {0};
@@ -15,17 +22,45 @@ static uint64_t lfreq[N_LETTERS] = {0};
 
 #define idx(pair) ((*(pair) - 'A')*26 + *((pair) + 1) - 'A')
 
+// the compiled-in template and rules, or those of AOC64_INPUT on the host (see parse_input)
+static const char* polymer = polymer_template;
+static const char* const (*insertions)[2] = rules;
+static int16_t n_insertions = n_rules;
+
+#ifndef __mos6502__
+static const char* file_rules[N_LETTERS*N_LETTERS][2];
+
+// the template (first line) and the "AB -> C" rules of AOC64_INPUT, false if it is not set
+bool parse_input() {
+    const char* const* lines;
+    size_t n;
+    if (!input_lines(lines, n))
+        return false;
+    polymer = lines[0];
+    n_insertions = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (*lines[i] == 0)
+            continue;
+        assert(n_insertions < N_LETTERS*N_LETTERS);
+        file_rules[n_insertions][0] = lines[i];
+        file_rules[n_insertions++][1] = lines[i] + 6;
+    }
+    insertions = file_rules;
+    return true;
+}
+#endif
+
 
 void polymerize(const int8_t niter) {
     for (int8_t s = 0; s < niter; ++s) {
         memcpy_reu(pfreq_new, pfreq, N_LETTERS*N_LETTERS*sizeof(pfreq[0]));
-        for (int8_t i = 0; i < n_rules; ++i) {
+        for (int16_t i = 0; i < n_insertions; ++i) {
             tick((i >> 4) & (uint8_t)7);
-            const char* const pair = rules[i][0];
+            const char* const pair = insertions[i][0];
             const int16_t ri = idx(pair);
             const uint64_t pcount = pfreq[ri];
             if (pcount > 0) {
-                const char new_element = rules[i][1][0];
+                const char new_element = insertions[i][1][0];
                 lfreq[new_element - 'A'] += pcount;
                 char new_pair[3] = {pair[0], new_element, pair[1]};
                 pfreq_new[idx(new_pair)] += pcount;
@@ -38,18 +73,60 @@ void polymerize(const int8_t niter) {
 }
 
 
-int main(void) {
-    init(14);
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(rules), decltype(polymer), decltype(insertions), decltype(n_insertions),
+             decltype(pfreq), decltype(pfreq_new), decltype(lfreq));
+
+#ifndef __mos6502__
+// with --steps n, the host prints the difference after n steps instead, from the matrix powers of
+// matrix.h: exact while it fits in 128 bits, and modulo p (< 2^32) with --mod p
+static unsigned long long steps = 0, mod = 0;
 
-    // initialize frequency tables with the initial polymer template
-    const int8_t template_len = strlen(polymer_template);
-    for (int8_t i = 0; i < template_len; ++i) {
+void solve_steps() {
+    phase("steps");
+    if (mod == 0) {
+        Exact exact;
+        Exact::T counts[ELEMENTS];
+        polymer_counts(exact, polymer, insertions, n_insertions, steps, counts);
+        if (exact.overflow) {
+            printf("steps %llu: more than 128 bits, use --mod p\n", steps);
+            return;
+        }
+        Exact::T min = 0, max = 0;
+        for (uint8_t i = 0; i < ELEMENTS; ++i) {
+            if (counts[i] == 0) continue;
+            if (min == 0 || counts[i] < min) min = counts[i];
+            if (counts[i] > max) max = counts[i];
+        }
+        printf("steps %llu: %s\n", steps, decimal(max - min));
+        return;
+    }
+    printf("steps %llu mod %llu: %llu\n", steps, mod,
+           (unsigned long long)difference_mod(polymer, insertions, n_insertions, steps, mod));
+}
+#endif
+
+void solve() {
+#ifndef __mos6502__
+    parse_input();
+    if (steps > 0) {
+        solve_steps();
+        return;
+    }
+#endif
+
+    phase("parse");
+    // initialize frequency tables with the initial polymer template (after a previous input of a batch)
+    memset(pfreq, 0, sizeof(pfreq));
+    memset(lfreq, 0, sizeof(lfreq));
+    const size_t template_len = strlen(polymer);
+    for (size_t i = 0; i < template_len; ++i) {
         if (i < template_len - 1)
-            pfreq[idx(polymer_template + i)] += 1;
-        lfreq[polymer_template[i] - 'A'] += 1;
+            pfreq[idx(polymer + i)] += 1;
+        lfreq[polymer[i] - 'A'] += 1;
     }
 
     // part 1
+    phase("part 1");
     polymerize(10);
     uint64_t min = UINT64_MAX, max = 0;
     for (int8_t i = 0; i < N_LETTERS; ++i) {
@@ -60,6 +137,7 @@ int main(void) {
     printf("part 1: %lld\n", max - min);
 
     // part 2
+    phase("part 2");
     polymerize(30);
     min = UINT64_MAX, max = 0;
     for (int8_t i = 0; i < N_LETTERS; ++i) {
@@ -70,5 +148,22 @@ int main(void) {
     printf("part 2: %lld\n", max - min);
 
     printf("\n");
+}
+
+int main(int argc, char** argv) {
+    int skip = 0;
+#ifndef __mos6502__
+    const Option options[] = {{"--steps", 1, UINT64_MAX, &steps}, {"--mod", 2, UINT32_MAX, &mod}};
+    skip = parse_options(argc, argv, options);
+    if (skip < 0 || (mod && steps == 0)) {
+        fprintf(stderr, "usage: %s [--steps n [--mod p (2 .. 2^32-1)]] [input ... | -]\n", argv[0]);
+        return 2;
+    }
+#endif
+    init(14);
+    // the inputs of a batch follow the options
+    if (!batch(argc - skip, argv + skip, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,229 @@
+#ifndef __MATRIX_H__
+#define __MATRIX_H__
+
+// Host engine for day 14 (--steps): the element counts after any number of steps, by matrix
+// exponentiation. Only the pairs reachable from the template are kept (P of the 26x26), the
+// step is the P x P matrix M of the rules (pair ab with rule c becomes ac and cb), and the pair
+// counts after n steps are M^n times those of the template, with M squared log2(n) times:
+// O(P^3 log n), e.g. 10^6 steps of a 10 element puzzle input (about 100 pairs) in milliseconds. The counts
+// grow exponentially, so the arithmetic is a parameter: Exact in 128 bits (about 120 steps),
+// Modular, Presence (which counts are not 0) and Logarithmic (a mantissa and a separate exponent)
+// to rank the elements when only the counts modulo p are known.
+#include <cmath>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+constexpr uint8_t ELEMENTS = 26;
+
+// The arithmetics: values T, sums of products accumulated in Acc (mul_add) and brought back to T (reduce)
+
+// unsigned 128 bit, remembers overflows
+struct Exact {
+    typedef unsigned __int128 T;
+    typedef T Acc;
+    bool overflow = false;
+    T add(const T a, const T b) {
+        T r;
+        overflow |= __builtin_add_overflow(a, b, &r);
+        return r;
+    }
+    Acc mul_add(const Acc s, const T a, const T b) {
+        T r;
+        overflow |= __builtin_mul_overflow(a, b, &r);
+        return add(s, r);
+    }
+    T reduce(const Acc s) { return s; }
+    void normalize(std::vector<T>&) {}
+};
+
+// modulo p (< 2^32): the products fit in 64 bits and their sums in 128, reduced once per entry
+struct Modular {
+    typedef uint64_t T;
+    typedef unsigned __int128 Acc;
+    uint64_t p;
+    T add(const T a, const T b) { return (a + b) % p; }
+    Acc mul_add(const Acc s, const T a, const T b) { return s + a * b; }
+    T reduce(const Acc s) { return s % p; }
+    void normalize(std::vector<T>&) {}
+};
+
+// the counts that are not 0: the pairs (and elements) reachable in exactly that many steps
+struct Presence {
+    typedef uint8_t T;
+    typedef T Acc;
+    T add(const T a, const T b) { return a | b; }
+    Acc mul_add(const Acc s, const T a, const T b) { return s | (a & b); }
+    T reduce(const Acc s) { return s; }
+    void normalize(std::vector<T>&) {}
+};
+
+// m 2^e with m in [0.5, 1) (or 0): the rare elements grow slower than the common ones by a
+// fraction of a bit per step, a long double scaled by the largest count underflows within 10^5
+// steps, a separate exponent does not
+struct Magnitude {
+    long double m;
+    int64_t e;
+
+    Magnitude(const long double x = 0) : m(x), e(0) { normalize(); }
+    Magnitude(const long double x, const int64_t exponent) : m(x), e(exponent) { normalize(); }
+    void normalize() {
+        int k;
+        m = std::frexp(m, &k);
+        e = m == 0 ? 0 : e + k;
+    }
+    bool operator==(const Magnitude& o) const { return m == o.m && e == o.e; }
+    bool operator!=(const Magnitude& o) const { return !(*this == o); }
+    bool operator<(const Magnitude& o) const {
+        if (m == 0 || o.m == 0)
+            return o.m != 0;
+        return e != o.e ? e < o.e : m < o.m;
+    }
+};
+
+// the counts as Magnitudes, exact up to the 64 bits of the mantissa
+struct Logarithmic {
+    typedef Magnitude T;
+    typedef T Acc;
+    T add(const T a, const T b) {
+        if (a.m == 0 || b.m == 0)
+            return a.m == 0 ? b : a;
+        // the smaller one shifted to the exponent of the larger one, nothing left of it beyond 2^-16384
+        return a.e >= b.e ? T(a.m + std::ldexp(b.m, b.e - a.e < -16384 ? -16384 : b.e - a.e), a.e)
+                          : T(b.m + std::ldexp(a.m, a.e - b.e < -16384 ? -16384 : a.e - b.e), b.e);
+    }
+    Acc mul_add(const Acc s, const T a, const T b) { return add(s, T(a.m * b.m, a.e + b.e)); }
+    T reduce(const Acc s) { return s; }
+    void normalize(std::vector<T>&) {}
+};
+
+// The count of each element (0 for the absent ones) after steps of the rules on the template
+template <typename Ring>
+void polymer_counts(Ring& ring, const char* const polymer, const char* const (*const rules)[2], const size_t n_rules,
+                    uint64_t steps, typename Ring::T (&counts)[ELEMENTS]) {
+    typedef typename Ring::T T;
+    typedef typename Ring::Acc Acc;
+    // the element inserted into each pair, -1 without a rule. The polymer is followed by END, so that
+    // every element is the first of a pair, the last one of that with END which never changes
+    constexpr uint8_t END = ELEMENTS, SIDE = ELEMENTS + 1;
+    int8_t insert[SIDE * SIDE];
+    memset(insert, -1, sizeof(insert));
+    for (size_t i = 0; i < n_rules; ++i)
+        insert[(rules[i][0][0] - 'A') * SIDE + rules[i][0][1] - 'A'] = rules[i][1][0] - 'A';
+
+    // the reachable pairs, numbered in the order they are found
+    const size_t len = strlen(polymer);
+    int16_t index[SIDE * SIDE];
+    memset(index, -1, sizeof(index));
+    std::vector<int16_t> pairs;
+    auto reach = [&](const int16_t pair) {
+        if (index[pair] < 0) {
+            index[pair] = pairs.size();
+            pairs.push_back(pair);
+        }
+    };
+    for (size_t i = 0; i < len; ++i)
+        reach((polymer[i] - 'A') * SIDE + (i + 1 < len ? polymer[i + 1] - 'A' : END));
+    for (size_t k = 0; k < pairs.size(); ++k) {
+        const int16_t a = pairs[k] / SIDE, b = pairs[k] % SIDE, c = insert[pairs[k]];
+        if (c >= 0) {
+            reach(a * SIDE + c);
+            reach(c * SIDE + b);
+        }
+    }
+    const size_t n = pairs.size();
+
+    // the step: m[to * n + from] pairs to from each from
+    std::vector<T> m(n * n, T(0));
+    for (size_t k = 0; k < n; ++k) {
+        const int16_t a = pairs[k] / SIDE, b = pairs[k] % SIDE, c = insert[pairs[k]];
+        if (c >= 0) {
+            T& left = m[index[a * SIDE + c] * n + k];
+            left = ring.add(left, T(1));
+            T& right = m[index[c * SIDE + b] * n + k];
+            right = ring.add(right, T(1));
+        } else {
+            m[k * n + k] = T(1);
+        }
+    }
+    std::vector<T> v(n, T(0));
+    for (size_t i = 0; i < len; ++i) {
+        const int16_t k = index[(polymer[i] - 'A') * SIDE + (i + 1 < len ? polymer[i + 1] - 'A' : END)];
+        v[k] = ring.add(v[k], T(1));
+    }
+
+    // v = M^steps v, the powers of M applied to v for the bits of steps, M squared in between
+    std::vector<T> w(n), square(n * n);
+    std::vector<Acc> row(n);
+    for (; steps; steps >>= 1) {
+        if (steps & 1) {
+            for (size_t i = 0; i < n; ++i) {
+                Acc s = Acc(0);
+                for (size_t j = 0; j < n; ++j)
+                    if (m[i * n + j] != T(0))
+                        s = ring.mul_add(s, m[i * n + j], v[j]);
+                w[i] = ring.reduce(s);
+            }
+            v.swap(w);
+            ring.normalize(v);
+        }
+        if (steps > 1) {
+            // row by row, the rows of m weighted by those of the row of m
+            for (size_t i = 0; i < n; ++i) {
+                std::fill(row.begin(), row.end(), Acc(0));
+                for (size_t k = 0; k < n; ++k) {
+                    const T a = m[i * n + k];
+                    if (a == T(0))
+                        continue;
+                    for (size_t j = 0; j < n; ++j)
+                        row[j] = ring.mul_add(row[j], a, m[k * n + j]);
+                }
+                for (size_t j = 0; j < n; ++j)
+                    square[i * n + j] = ring.reduce(row[j]);
+            }
+            m.swap(square);
+            ring.normalize(m);
+        }
+    }
+
+    for (T& c : counts)
+        c = T(0);
+    for (size_t k = 0; k < n; ++k)
+        counts[pairs[k] / SIDE] = ring.add(counts[pairs[k] / SIDE], v[k]);
+}
+
+// The difference of the most and the least common element after steps, modulo p: the elements
+// present from the pairs reachable in that many steps, ranked by their Magnitudes
+inline uint64_t difference_mod(const char* const polymer, const char* const (*const rules)[2], const size_t n_rules,
+                               const uint64_t steps, const uint64_t p) {
+    Presence presence;
+    uint8_t present[ELEMENTS];
+    polymer_counts(presence, polymer, rules, n_rules, steps, present);
+    Logarithmic logarithmic;
+    Magnitude approx[ELEMENTS];
+    polymer_counts(logarithmic, polymer, rules, n_rules, steps, approx);
+    Modular modular {p};
+    uint64_t counts[ELEMENTS];
+    polymer_counts(modular, polymer, rules, n_rules, steps, counts);
+    int8_t min = -1, max = -1;
+    for (int8_t i = 0; i < ELEMENTS; ++i) {
+        if (!present[i]) continue;
+        if (min < 0 || approx[i] < approx[min]) min = i;
+        if (max < 0 || approx[max] < approx[i]) max = i;
+    }
+    return (counts[max] + p - counts[min]) % p;
+}
+
+// The decimal digits of v
+inline const char* decimal(unsigned __int128 v) {
+    static char buf[48];
+    char* p = buf + sizeof(buf) - 1;
+    *p = 0;
+    do {
+        *--p = '0' + (char)(v % 10);
+        v /= 10;
+    } while (v);
+    return p;
+}
+
+#endif // __MATRIX_H__
@@ -1,103 +1,195 @@
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "AoC64.h"
-#include "min_heap.h"
+#include "input_file.h"
+#include "batch.h"
+#include "options.h"
+#include "progress.h"
+#include "queue.h"
 #include "reucpy.h"
-#if __has_include("input.h")
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
+#ifndef __mos6502__
+  #include <vector>
+#endif
 
-// size of the open set for Dijkstra using priority queue
-// the closed set is living on the REU (starting at address 0)
-constexpr int16_t open_size = 2048;
-// grid expansion for part 2
+// grid expansion for part 2 (on the host, --multiply k for another)
 constexpr uint8_t multipy = 5;
+static uint16_t expansion = multipy;
 
-struct Point {
-    int16_t y;
-    int16_t x;
-
-    const Point up()    const { return Point {.y = (y-1), .x = x}; }
-    const Point down()  const { return Point {.y = (y+1), .x = x}; }
-    const Point left()  const { return Point {.y = y, .x = (x-1)}; }
-    const Point right() const { return Point {.y = y, .x = (x+1)}; }
-    int8_t equal(const Point& other) const { return y == other.y && x == other.x; }
-};
+// the compiled-in risk levels, or the digits of the lines of AOC64_INPUT on the host (see solve)
+static const char* const* risk_lines = nullptr;
+static uint16_t dim = base_dim;
 
-struct Node {
-    int16_t priority;
-    Point p;
-};
+inline uint8_t base_risk(const uint16_t y, const uint16_t x) {
+    return risk_lines ? risk_lines[y][x] - '0' : risk[y][x];
+}
 
-// open set
-Heap<Node, int16_t, open_size> open;
+// The expanded risk map is generated once per part, row by row with additions only, each cell a
+// byte holding its risk and a closed flag, in a frame of closed cells so that the neighbours of a
+// cell are its index +-1 and +-width without bounds checks. On the C64 it lives on the REU (a
+// cell is one byte of DMA), on the host in RAM.
+typedef uint32_t Index;
+constexpr uint8_t CLOSED = 0x80;
+
+#ifdef __mos6502__
+inline uint8_t cell(const Index i) {
+    uint8_t data;
+    reucpy((void*)&data, i, 1, REU2RAM);
+    return data;
+}
 
+inline void set_closed(const Index i, const uint8_t data) {
+    const uint8_t closed[1] = {(uint8_t)(data | CLOSED)};
+    reucpy((void*)closed, i, 1, RAM2REU);
+}
 
-inline uint8_t is_closed(const Point& p, const int16_t dim) {
-    int8_t data;
-    reucpy((void *)&data, (reu_addr_t)dim * p.y + p.x, 1, REU2RAM);
-    return data;
+inline void store_row(const Index i, const uint8_t* const row, const uint16_t width) {
+    reucpy((void*)row, i, width, RAM2REU);
 }
+#else
+static std::vector<uint8_t> grid;
 
-inline void set_closed(const Point& p, const int16_t dim) {
-    const uint8_t data[1] = { 0xFF };
-    reucpy((void *)data, (reu_addr_t)dim * p.y + p.x, 1, RAM2REU);
+inline uint8_t cell(const Index i) { return grid[i]; }
+inline void set_closed(const Index i, const uint8_t data) { grid[i] = data | CLOSED; }
+inline void store_row(const Index i, const uint8_t* const row, const uint16_t width) {
+    memcpy(&grid[i], row, width);
 }
+#endif
 
-inline int8_t risk_level(const Point& p) {
-    const int8_t tx = p.x / base_dim;
-    const int8_t ty = p.y / base_dim;
-    return 1 + (risk[p.y % base_dim][p.x % base_dim] + tx + ty - 1) % 9;
+// widest row of the map with its frame
+#ifdef __mos6502__
+constexpr uint16_t MAX_WIDTH = multipy * base_dim + 2;
+#else
+constexpr uint16_t MAX_WIDTH = 32767;
+#endif
+
+// The map of mult x mult tiles, returns its width with the frame
+uint16_t generate(const uint16_t mult) {
+    const uint32_t wide = (uint32_t)mult * dim + 2;
+    if (wide > MAX_WIDTH) {
+        fprintf(stderr, "error: %u x %u tiles are wider than %u cells\n", (unsigned)mult, (unsigned)mult, (unsigned)MAX_WIDTH);
+        exit(1);
+    }
+    const uint16_t width = wide;
+#ifndef __mos6502__
+    grid.assign((size_t)width * width, 0);
+#endif
+    static uint8_t row[MAX_WIDTH];
+    memset(row, CLOSED, width);
+    store_row(0, row, width);
+    store_row((Index)(width - 1) * width, row, width);
+    Index at = width;
+    for (uint16_t ty = 0; ty < mult; ++ty) {
+        for (uint16_t y = 0; y < dim; ++y, at += width) {
+            // each tile one more than the one to its left, 9 wraps around to 1
+            uint16_t x = 1;
+            for (uint16_t c = 0; c < dim; ++c, ++x) {
+                uint8_t r = base_risk(y, c);
+                for (uint16_t k = 0; k < ty; ++k)
+                    r = r == 9 ? 1 : r + 1;
+                row[x] = r;
+            }
+            for (; x < width - 1; ++x)
+                row[x] = row[x - dim] == 9 ? 1 : row[x - dim] + 1;
+            store_row(at, row, width);
+        }
+    }
+    return width;
 }
 
-inline void explore(const Point& p, const int16_t priority, const int16_t dim) {
-    if (p.x < 0 || p.x >= dim || p.y < 0 || p.y >= dim || is_closed(p, dim))
-        return;
-    set_closed(p, dim);
-    open.push(Node {.priority = priority + risk_level(p), .p = p});
+// Dial's algorithm: the risks are 1..9, so the open cells are at most 9 more than the current
+// distance, kept in a ring of 10 buckets
+constexpr uint8_t N_BUCKETS = 10;
+#ifdef __mos6502__
+constexpr uint16_t BUCKET_SIZE = 512;
+#else
+constexpr uint16_t BUCKET_SIZE = 65535;
+#endif
+static Queue<Index, uint16_t, BUCKET_SIZE> buckets[N_BUCKETS];
+
+// A cell is closed when first reached: all paths into it pay its risk, so that one is the shortest.
+// Returns whether it was opened.
+inline uint8_t explore(const Index i, const uint8_t slot) {
+    const uint8_t data = cell(i);
+    if (data & CLOSED)
+        return 0;
+    set_closed(i, data);
+    const uint8_t to = slot + data;
+    buckets[to < N_BUCKETS ? to : to - N_BUCKETS].push(i);
+    return 1;
 }
 
-int16_t find_path(const int8_t mult) {
-
-    const int16_t mdim = mult*base_dim;
-    const Point start = Point {.y = 0, .x = 0};
-    const Point end = Point {.y = mdim - 1, .x = mdim - 1};
-
-    const Node n0 = {.priority = 0, .p = start};
-    open.init(&n0, 1);
-    set_closed(start, mdim);
-
-    int32_t iter = 0;
-    while (open.size()) {
-        tick((iter >> 4) & (uint8_t)7);
-        Node curr = open.pop();
-        if (curr.p.equal(end))
-            return curr.priority;
-        explore(curr.p.left(),  curr.priority, mdim);
-        explore(curr.p.right(), curr.priority, mdim);
-        explore(curr.p.up(),    curr.priority, mdim);
-        explore(curr.p.down(),  curr.priority, mdim);
-        ++iter;
+int32_t find_path(const uint16_t mult) {
+    const uint16_t width = generate(mult);
+    const Index start = width + 1;
+    const Index end = (Index)(width - 1) * width - 2;
+
+    for (uint8_t b = 0; b < N_BUCKETS; ++b)
+        buckets[b].clear();
+    set_closed(start, cell(start));
+    buckets[0].push(start);
+    uint32_t open = 1;
+
+    Progress<4> progress("nodes", (uint32_t)(width - 2) * (width - 2));
+    uint8_t slot = 0;
+    for (int32_t distance = 0; open; ++distance) {
+        Queue<Index, uint16_t, BUCKET_SIZE>& bucket = buckets[slot];
+        while (bucket.size()) {
+            progress.step();
+            const Index i = bucket.pop();
+            --open;
+            if (i == end)
+                return distance;
+            open += explore(i - 1, slot) + explore(i + 1, slot) + explore(i - width, slot) + explore(i + width, slot);
+        }
+        if (++slot == N_BUCKETS)
+            slot = 0;
     }
     return 0;
 }
 
+AOC64_BUDGET(C64_DATA_RAM, REU_512K, decltype(expansion), decltype(risk), decltype(risk_lines), decltype(dim), decltype(buckets), uint8_t[MAX_WIDTH],
+             Region<0, (uint32_t)MAX_WIDTH * MAX_WIDTH>);
 
-int main(void) {
-    init(15);
+void solve() {
+    size_t n;
+    if (input_lines(risk_lines, n)) {
+        dim = n;
+        assert(strlen(risk_lines[0]) == dim);
+    }
 
-    // needs REU
-    reu_init();
-    const uint16_t nbanks = banks_needed((uint32_t)multipy*multipy*base_dim*base_dim);
+    phase("part 1");
+    printf("part 1: %ld\n", find_path(1));
 
-    reu_clear(nbanks);
-    printf("part 1: %d\n", find_path(1));
+    phase("part 2");
+    printf("part 2: %ld\n", find_path(expansion));
+}
 
-    reu_clear(nbanks);
-    printf("part 2: %d\n", find_path(multipy));
+int main(int argc, char** argv) {
+    int skip = 0;
+#ifndef __mos6502__
+    unsigned long long k = expansion;
+    const Option options[] = {{"--multiply", 1, (MAX_WIDTH - 2) / base_dim, &k}};
+    skip = parse_options(argc, argv, options);
+    if (skip < 0) {
+        fprintf(stderr, "usage: %s [--multiply k (1 .. %u)] [input ... | -]\n", argv[0], (unsigned)((MAX_WIDTH - 2) / base_dim));
+        return 2;
+    }
+    expansion = k;
+#endif
+    init(15);
 
+    // needs REU
+    reu_init();
+    // the inputs of a batch follow the options
+    if (!batch(argc - skip, argv + skip, solve))
+        solve();
     finish();
+    return 0;
 }
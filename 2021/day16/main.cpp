@@ -1,8 +1,11 @@
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "AoC64.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
@@ -118,14 +121,28 @@ uint64_t decode(const char* packet, uint16_t& bit_offset, uint16_t& bits_read) {
 }
 
 
-int main(void) {
-    init(16);
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(input), decltype(g_sum_versions));
+
+// solves the compiled-in transmission, or that of AOC64_INPUT on the host
+void solve() {
+    const char* const* lines = input;
+    size_t n;
+    input_lines(lines, n);
+    // the bit offsets are 16 bit
+    assert(strlen(lines[0]) < 0x4000);
 
+    g_sum_versions = 0;
     uint16_t bit_offset = 0, len;
-    uint64_t value = decode(input[0], bit_offset, len);
+    uint64_t value = decode(lines[0], bit_offset, len);
 
     printf("part 1: %u\n", g_sum_versions);
     printf("part 2: %llu\n", value);
+}
 
+int main(int argc, char** argv) {
+    init(16);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
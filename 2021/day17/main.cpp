@@ -1,17 +1,23 @@
+#include <assert.h>
 #include <stdio.h>
 #include "AoC64.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
 
+// the compiled-in target area, or that of AOC64_INPUT on the host (see solve)
+static const int16_t (*area)[2] = target;
+
 inline int8_t inside(const int16_t x, const int16_t y) {
-    return x >= target[0][0] && x <= target[0][1] && y >= target[1][0] && y <= target[1][1];
+    return x >= area[0][0] && x <= area[0][1] && y >= area[1][0] && y <= area[1][1];
 }
 
 inline int8_t overshoot(const int16_t x, const int16_t y) {
-    return x > target[0][1] || y < target[1][0];
+    return x > area[0][1] || y < area[1][0];
 }
 
 inline int16_t shoot(int16_t vx, int16_t vy) {
@@ -29,14 +35,18 @@ inline int16_t shoot(int16_t vx, int16_t vy) {
     }
 }
 
-int main(void) {
-    init(17);
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(target), decltype(area));
+
+void solve() {
+    size_t n;
+    if (input_numbers(area, n))
+        assert(n == 2);
 
     int16_t vx, vy, maxy = 0, hits = 0;
-    for (vx = 0; vx <= target[0][1]; ++vx) {
-        if ((vx*(vx+1) >> 1) < target[0][0]) continue;
+    for (vx = 0; vx <= area[0][1]; ++vx) {
+        if ((vx*(vx+1) >> 1) < area[0][0]) continue;
         tick(vx & (uint8_t)7);
-        for (vy = target[1][0]; vy < -target[1][0]; ++vy) {
+        for (vy = area[1][0]; vy < -area[1][0]; ++vy) {
             const int16_t y = shoot(vx, vy);
             if (y >= 0) {
                 ++hits;
@@ -46,6 +56,12 @@ int main(void) {
     }
     printf("part 1: %d\n", maxy);
     printf("part 2: %d\n", hits);
+}
 
+int main(int argc, char** argv) {
+    init(17);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
+#include <assert.h>
 #include <stdio.h>
 #include "AoC64.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
@@ -97,24 +100,45 @@ inline int16_t magnitude(int16_t *v, int8_t d) {
     return *v == -1 ? 3 * magnitude(v - d, d/2) + 2 * magnitude(v + d, d/2) : *v;
 }
 
-int main(void) {
-    init(18);
+// the compiled-in numbers, or those of AOC64_INPUT on the host (see solve)
+static const char* const* homework = input;
+static int16_t n_homework = n_input;
+
+#ifdef __mos6502__
+constexpr int16_t MAX_NUMBERS = n_input;
+#else
+constexpr int16_t MAX_NUMBERS = 4096;
+#endif
+static Tree numbers[MAX_NUMBERS];
 
-    Tree numbers[n_input], result;
-    parse(input[0], numbers[0].v + MAX_TREE_SIZE/2, 8);
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(input), decltype(homework), decltype(n_homework), decltype(numbers), Tree[2]);
+
+void solve() {
+    input_lines(homework, n_homework);
+    assert(n_homework <= MAX_NUMBERS);
+
+    phase("part 1");
+    Tree result;
+    // the pairs are not written by parse(), the trees of a previous input of a batch are cleared
+    const char* s = homework[0];
+    numbers[0].clear();
+    parse(s, numbers[0].v + MAX_TREE_SIZE/2, 8);
     Tree sum = numbers[0];
-    for (int8_t i = 1; i < n_input; ++i) {
+    for (int16_t i = 1; i < n_homework; ++i) {
         tick(i & (uint8_t)7);
-        parse(input[i], numbers[i].v + MAX_TREE_SIZE/2, 8);
+        s = homework[i];
+        numbers[i].clear();
+        parse(s, numbers[i].v + MAX_TREE_SIZE/2, 8);
         add(sum, numbers[i], result);
         sum = result;
     }
     printf("part 1: %d\n", magnitude(sum.v + MAX_TREE_SIZE/2, 8));
 
+    phase("part 2");
     int16_t largest = 0;
     int16_t t = 0;
-    for (int8_t i = 0; i < n_input; ++i) {
-        for (int8_t j = 0; j < n_input; ++j) {
+    for (int16_t i = 0; i < n_homework; ++i) {
+        for (int16_t j = 0; j < n_homework; ++j) {
             tick((++t >> 3) & (uint8_t)7);
             add(numbers[i], numbers[j], result);
             int16_t m = magnitude(result.v + MAX_TREE_SIZE/2, 8);
@@ -123,6 +147,12 @@ int main(void) {
         }
     }
     printf("part 2: %d\n", largest);
+}
 
+int main(int argc, char** argv) {
+    init(18);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
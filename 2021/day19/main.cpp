@@ -1,5 +1,8 @@
+#include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include "AoC64.h"
+#include "progress.h"
 #include "min_heap.h"
 #include "hashset.h"
 #include "pearson.h"
@@ -8,12 +11,34 @@
 #include "stack_reu.h"
 #include "point.h"
 #include "rotations.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
 
+#ifdef __mos6502__
+// the puzzle's scanners
+constexpr uint8_t MAX_SCANNERS = n_scanners;
+constexpr uint8_t MAX_BEACONS = n_beacons;
+constexpr uint16_t MAX_POINTS = 1024;
+constexpr uint16_t MAX_MAPPINGS = 50;
+#else
+constexpr uint8_t MAX_SCANNERS = 255;
+constexpr uint8_t MAX_BEACONS = 40;
+constexpr uint16_t MAX_POINTS = 32768;
+constexpr uint16_t MAX_MAPPINGS = 2048;
+#endif
+constexpr uint16_t MAX_BEACON_PAIRS = (MAX_BEACONS - 1) * MAX_BEACONS / 2;
+
+// the compiled-in scanners, or those of AOC64_INPUT on the host (see parse_input): the beacons of
+// each scanner in beacon_slots slots, the unused ones at 0,0,0
+static Point* beacons[MAX_SCANNERS];
+static uint8_t scanner_count = n_scanners;
+static uint8_t beacon_slots = n_beacons;
+
 // structure for the distance fingerprint between beacons i and j
 struct Distance {
     uint24_t priority;
@@ -21,34 +46,35 @@ struct Distance {
     uint8_t j;
 };
 // distance fingerprints for each scanner stored on the REU
-typedef StackREU<Distance, uint16_t, n_beacon_pairs> Fingerprint;
-Fingerprint _fingerprints[n_scanners];
-Point _scanner_pos[n_scanners];
+typedef StackREU<Distance, uint16_t, MAX_BEACON_PAIRS> Fingerprint;
+Fingerprint _fingerprints[MAX_SCANNERS];
+Point _scanner_pos[MAX_SCANNERS];
 // complication due to uneven number of beacons per scanner
-uint16_t _fp_lengths[n_scanners];
-uint8_t _num_beacons[n_scanners];
-uint8_t t = 0;
+uint16_t _fp_lengths[MAX_SCANNERS];
+uint8_t _num_beacons[MAX_SCANNERS];
+Progress<0> progress("scanners");
 
 
 void get_distance_fingerprints() {
     // used for sortin the distance hashes
-    static Heap<Distance, uint16_t, n_beacon_pairs> dist_hashes;
+    static Heap<Distance, uint16_t, MAX_BEACON_PAIRS> dist_hashes;
     dist_hashes.clear();
     // iterate over scanners and store the distance hashes in the REU
     uint24_t addr = 0;
     constexpr uint16_t fp_size = 2048;
-    for (uint8_t s = 0; s < n_scanners; ++s) {
-        tick(t++ & (uint8_t)7);
+    for (uint8_t s = 0; s < scanner_count; ++s) {
+        progress.step();
         _fingerprints[s].init(addr);
+        _fp_lengths[s] = 0;
         addr += fp_size;
         dist_hashes.clear();
-        const Point* const& points = scanners[s];
+        const Point* const& points = beacons[s];
         uint8_t i;
         // iterate over pairs of beacons
-        for (i = 0; i < n_beacons; ++i) {
+        for (i = 0; i < beacon_slots; ++i) {
             if (points[i].empty()) break;
             uint16_t dd[3];
-            for (uint8_t j = i + 1; j < n_beacons; ++j) {
+            for (uint8_t j = i + 1; j < beacon_slots; ++j) {
                 // take the 24-bit Pearson hash of the sored partial L1 distances
                 dd[0] = ABS(points[i].x - points[j].x);
                 dd[1] = ABS(points[i].y - points[j].y);
@@ -75,8 +101,8 @@ void get_distance_fingerprints() {
 
 // for the mapping it is enough to identify a single pair of beacon pairs
 struct Mapping {
-    int8_t s1;              // scanner 1 index
-    int8_t s2;              // scanner 1 index
+    uint8_t s1;             // scanner 1 index
+    uint8_t s2;             // scanner 2 index
     int8_t idx1[12];        // beacon IDs for scanner 1
     int8_t idx2[12];        // beacon IDs for scanner 2
     int8_t matched_pair[4]; // IDs for pair of beacons of identical distance fingerprint
@@ -91,13 +117,15 @@ struct Mapping {
     }
 };
 // global variable to hold all the identified mappings
-Mapping _mappings[50];
-int8_t _n_mappings = 0;
+Mapping _mappings[MAX_MAPPINGS];
+uint16_t _n_mappings = 0;
 
 void find_matches() {
-    for (uint8_t s1 = 0; s1 < n_scanners; ++s1) {
-        tick(t++ & (uint8_t)7);
-        for (uint8_t s2 = s1 + 1; s2 < n_scanners; ++s2) {
+    _n_mappings = 0;
+    for (uint8_t s1 = 0; s1 < scanner_count; ++s1) {
+        progress.step();
+        for (uint8_t s2 = s1 + 1; s2 < scanner_count; ++s2) {
+            assert(_n_mappings < MAX_MAPPINGS);
             Mapping& m = _mappings[_n_mappings];
             const Fingerprint& f1 = _fingerprints[s1];
             const Fingerprint& f2 = _fingerprints[s2];
@@ -107,8 +135,8 @@ void find_matches() {
             const uint16_t len2 = _fp_lengths[s2];
             uint8_t point_pair_found = 0;
             uint16_t i = 0, j = 0;
-            uint8_t idx1[n_beacons] = {};
-            uint8_t idx2[n_beacons] = {};
+            uint8_t idx1[MAX_BEACONS] = {};
+            uint8_t idx2[MAX_BEACONS] = {};
             while (i < len1 && j < len2) {
                 f1.getInto(i, &dd1); f2.getInto(j, &dd2);
                 if (dd1.priority == dd2.priority) {
@@ -125,7 +153,7 @@ void find_matches() {
                 else ++j;
             }
             uint8_t l1 = 0, l2 = 0;
-            for (uint8_t k = 0; k < n_beacons; ++k) {
+            for (uint8_t k = 0; k < beacon_slots; ++k) {
                 if (idx1[k]) m.idx1[l1++] = k;
                 if (idx2[k]) m.idx2[l2++] = k;
             }
@@ -139,11 +167,11 @@ void find_matches() {
 
 
 void find_transformation(const Mapping& m, uint8_t& rotation_idx, Point& translation) {
-    const Point& p_A1 = scanners[m.s1][m.matched_pair[0]];
-    const Point p_B[2] = {scanners[m.s2][m.matched_pair[2]], scanners[m.s2][m.matched_pair[3]]};
+    const Point& p_A1 = beacons[m.s1][m.matched_pair[0]];
+    const Point p_B[2] = {beacons[m.s2][m.matched_pair[2]], beacons[m.s2][m.matched_pair[3]]};
     uint8_t j = 0;
     while (m.idx1[j] == m.matched_pair[0] || m.idx1[j] == m.matched_pair[1]) ++j;
-    const Point& original = scanners[m.s1][m.idx1[j]];
+    const Point& original = beacons[m.s1][m.idx1[j]];
     for (uint8_t i = 0; i < n_rotations; ++i) {
         const Matrix& rot = rotation_matrices[i];
         const Point trans_o[2] = {subtract_points(p_A1, rotate_point(p_B[0], rot)),
@@ -151,7 +179,7 @@ void find_transformation(const Mapping& m, uint8_t& rotation_idx, Point& transla
         for (uint8_t p = 0; p < 2; ++p) {
             const Point& trans = trans_o[p];
             for (uint8_t k = 0; k < 12; ++k) {
-                if (transform_point(scanners[m.s2][m.idx2[k]], rot, trans) == original) {
+                if (transform_point(beacons[m.s2][m.idx2[k]], rot, trans) == original) {
                     rotation_idx = i;
                     translation = trans;
                     return;
@@ -163,13 +191,13 @@ void find_transformation(const Mapping& m, uint8_t& rotation_idx, Point& transla
 
 
 void locate_scanners() {
-    uint8_t located[n_scanners] = {};
+    uint8_t located[MAX_SCANNERS] = {};
     located[0] = 1;
     uint8_t n_located = 1;
     _scanner_pos[0] = {0, 0, 0};
-    while (n_located < n_scanners) {
-        tick(t++ & (uint8_t)7);
-        for (uint8_t i = 0; i < _n_mappings; ++i) {
+    while (n_located < scanner_count) {
+        progress.step();
+        for (uint16_t i = 0; i < _n_mappings; ++i) {
             const Mapping& m = _mappings[i];
             if (!(located[m.s1] ^ located[m.s2]))
                 continue;
@@ -179,8 +207,8 @@ void locate_scanners() {
             find_transformation(n, rotation_idx, translation);
             // back-transform the points of the located scanner
             for (uint8_t j = 0; j < _num_beacons[n.s2]; ++j) {
-                scanners[n.s2][j] = transform_point(
-                    scanners[n.s2][j],
+                beacons[n.s2][j] = transform_point(
+                    beacons[n.s2][j],
                     rotation_matrices[rotation_idx],
                     translation
                 );
@@ -194,11 +222,11 @@ void locate_scanners() {
 
 
 uint16_t count_points() {
-    HashSet<Point, uint16_t, 1024> all_points;
+    HashSet<Point, uint16_t, MAX_POINTS> all_points;
     all_points.clear();
-    for (uint8_t s = 0; s < n_scanners; ++s) {
+    for (uint8_t s = 0; s < scanner_count; ++s) {
         for (uint8_t b = 0; b < _num_beacons[s]; ++b) {
-            all_points.insert(scanners[s][b]);
+            all_points.insert(beacons[s][b]);
         }
     }
     return all_points.size();
@@ -207,9 +235,9 @@ uint16_t count_points() {
 
 uint16_t max_scanner_distance() {
     uint16_t distance = 0;
-    for (uint8_t i = 0; i < n_scanners; ++i) {
+    for (uint8_t i = 0; i < scanner_count; ++i) {
         const Point& p1 = _scanner_pos[i];
-        for (uint8_t j = i + 1; j < n_scanners; ++j) {
+        for (uint8_t j = i + 1; j < scanner_count; ++j) {
             const Point& p2 = _scanner_pos[j];
             const uint16_t d = ABS(p1.x - p2.x) + ABS(p1.y - p2.y) + ABS(p1.z - p2.z);
             if (d > distance)
@@ -220,15 +248,75 @@ uint16_t max_scanner_distance() {
 }
 
 
-int main(void) {
-    init(19);
+AOC64_BUDGET(C64_DATA_RAM, REU_512K, decltype(scanners), decltype(beacons_per_scanner), decltype(beacons), decltype(scanner_count),
+             decltype(beacon_slots), decltype(_fingerprints), decltype(_scanner_pos), decltype(_fp_lengths), decltype(_num_beacons),
+             decltype(progress), decltype(_mappings), decltype(_n_mappings), Heap<Distance, uint16_t, MAX_BEACON_PAIRS>,
+             HashSet<Point, uint16_t, MAX_POINTS>);
+
+#ifndef __mos6502__
+static Point file_scanners[MAX_SCANNERS][MAX_BEACONS];
 
+// the beacons of AOC64_INPUT, each scanner headed by "--- scanner n ---", false if it is not set
+bool parse_input() {
+    const char* const* lines;
+    size_t n;
+    if (!input_lines(lines, n))
+        return false;
+    memset(file_scanners, 0, sizeof(file_scanners));
+    scanner_count = 0;
+    beacon_slots = 0;
+    uint8_t b = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const char* const line = lines[i];
+        if (*line == 0)
+            continue;
+        if (line[1] == '-') {
+            assert(scanner_count < MAX_SCANNERS);
+            ++scanner_count;
+            b = 0;
+            continue;
+        }
+        assert(scanner_count > 0 && b < MAX_BEACONS);
+        Point& q = file_scanners[scanner_count - 1][b++];
+        char* p;
+        q.x = strtol(line, &p, 10);
+        q.y = strtol(p + 1, &p, 10);
+        q.z = strtol(p + 1, nullptr, 10);
+        if (b > beacon_slots)
+            beacon_slots = b;
+    }
+    for (uint8_t s = 0; s < scanner_count; ++s)
+        beacons[s] = file_scanners[s];
+    return true;
+}
+#endif
+
+void solve() {
+    for (uint8_t s = 0; s < n_scanners; ++s)
+        beacons[s] = scanners[s];
+#ifndef __mos6502__
+    parse_input();
+#endif
+
+    phase("prints");
+    progress.reset();
     get_distance_fingerprints();
+    phase("match");
     find_matches();
+    phase("locate");
     locate_scanners();
 
+    progress.done();
+    phase("part 1");
     printf("part 1: %u\n", count_points());
+    phase("part 2");
     printf("part 2: %u\n", max_scanner_distance());
+}
 
+int main(int argc, char** argv) {
+    init(19);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
@@ -2,16 +2,29 @@
 #include <assert.h>
 #include <string.h>
 #include "AoC64.h"
+#include "progress.h"
 #include "reucpy.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
 
 
-constexpr uint16_t BUFF_SIZE = (uint16_t)(input_dim + 2*50)*(input_dim + 2*50) / 8 + 1;
-constexpr uint16_t MAX_DIM = input_dim + 2*50; // space for only up to 50 enhancements
+// the compiled-in algorithm and image, or those of AOC64_INPUT on the host (see solve)
+static const char* algorithm = input_algo;
+static const char* const* image_rows = input_map;
+static uint8_t image_dim = input_dim;
+
+#ifdef __mos6502__
+constexpr uint8_t MAX_INPUT_DIM = input_dim;
+#else
+constexpr uint8_t MAX_INPUT_DIM = 154; // 255 is -1 for getbit()
+#endif
+constexpr uint16_t BUFF_SIZE = (uint16_t)(MAX_INPUT_DIM + 2*50)*(MAX_INPUT_DIM + 2*50) / 8 + 1;
+constexpr uint16_t MAX_DIM = MAX_INPUT_DIM + 2*50; // space for only up to 50 enhancements
 
 struct Image {
     // backend arrays
@@ -50,13 +63,13 @@ inline void Image::flip_and_clear() {
 
 void Image::init() {
     reuset(0, 0, 1);
-    this->dim_original = input_dim;
-    this->dim_enhanced = input_dim + 2;
+    this->dim_original = image_dim;
+    this->dim_enhanced = image_dim + 2;
     this->bg_original = 0;
     this->bg_enhanced = 0;
-    for (uint8_t j = 0; j < input_dim; ++j)
-        for (uint8_t i = 0; i < input_dim; ++i)
-            if (input_map[j][i] == '#')
+    for (uint8_t j = 0; j < image_dim; ++j)
+        for (uint8_t i = 0; i < image_dim; ++i)
+            if (image_rows[j][i] == '#')
                 this->setbit(i, j);
     uint8_t* tmp = this->original;
     this->original = this->enhanced;
@@ -93,7 +106,7 @@ inline uint16_t Image::getindex(uint8_t i, uint8_t j) const {
     return idx;
 }
 
-static uint16_t t = 0;
+static Progress<1> progress("rows");
 void Image::enhance(const uint8_t nsteps, const uint8_t* const algo) {
     uint8_t step = 0;
     while (step < nsteps) {
@@ -102,7 +115,7 @@ void Image::enhance(const uint8_t nsteps, const uint8_t* const algo) {
         this->dim_enhanced = this->dim_original + 2;
         this->bg_enhanced = algo[0] ? step & (uint8_t)1 : 0;
         for (uint8_t j = 0; j < this->dim_enhanced; ++j) {
-            tick(t++ >> 1 & (uint8_t)7);
+            progress.step();
             const uint8_t jj = j-1;
             for (uint8_t i = 0; i < this->dim_enhanced; ++i) {
                 if (algo[this->getindex(i-1, jj)] != this->bg_enhanced)
@@ -111,6 +124,7 @@ void Image::enhance(const uint8_t nsteps, const uint8_t* const algo) {
         }
         this->flip_and_clear();
     }
+    progress.done();
 }
 
 inline uint16_t Image::count() const {
@@ -122,13 +136,25 @@ inline uint16_t Image::count() const {
 }
 
 
-int main(void) {
-    init(20);
+AOC64_BUDGET(C64_DATA_RAM, REU_128K, decltype(input_algo), decltype(input_map), decltype(algorithm), decltype(image_rows),
+             decltype(image_dim), Image, uint8_t[512], uint8_t[8], decltype(progress), Region<0, BUFF_SIZE>);
+
+void solve() {
+    const char* const* lines;
+    size_t n;
+    if (input_lines(lines, n)) {
+        // the algorithm, an empty line and the image
+        algorithm = lines[0];
+        image_rows = lines + 2;
+        image_dim = n - 2;
+        assert(n - 2 <= MAX_INPUT_DIM && strlen(image_rows[0]) == image_dim);
+    }
 
     // transform the algo input
+    phase("parse");
     uint8_t algo[512] = {0};
     for (int16_t i = 0; i < 512; ++i)
-        if (input_algo[i] == '#')
+        if (algorithm[i] == '#')
             algo[i] = 1;
 
     // load the input image
@@ -136,10 +162,18 @@ int main(void) {
     image.init();
 
     // enhance
+    phase("part 1");
     image.enhance(2, &algo[0]);
     printf("part 1: %u\n", image.count());
+    phase("part 2");
     image.enhance(48, &algo[0]);
     printf("part 2: %u\n", image.count());
+}
 
+int main(int argc, char** argv) {
+    init(20);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
@@ -1,14 +1,18 @@
+#include <assert.h>
 #include "AoC64.h"
-#include "hashmap_reu.h"
+#include "cuckoo_hashmap_reu.h"
+#include "cache.h"
 #include "pearson.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
 
+static uint8_t dice;  // the deterministic die, from 1 for each game
 uint8_t roll_dice() {
-    static uint8_t dice = 1;
     uint8_t ret = dice;
     if (++dice > 100)
         dice = 1;
@@ -19,6 +23,7 @@ uint32_t demo_play(uint8_t pos1, uint8_t pos2) {
     uint8_t pos[2] = {pos1, pos2};
     uint16_t score[2] = {0};
     uint16_t rolled = 0;
+    dice = 1;
     for (;;) {
         // player 1
         uint16_t roll = (uint16_t)roll_dice() + roll_dice() + roll_dice();
@@ -58,7 +63,9 @@ bool operator==(const GameState& lhs, const GameState& rhs) {
            lhs.pos2 == rhs.pos2 && lhs.score2 == rhs.score2;
 }
 
-HashMapREU<GameState, Wins, uint16_t, 20000> parallel_memo;
+// cuckoo map: a lookup costs at most 2 DMAs, even for misses at a high load
+// hot states are served from a small write-back RAM cache without any DMA
+CacheFront<CuckooHashMapREU<GameState, Wins, uint16_t, 24000>, GameState, Wins, 128, 2, true> parallel_memo;
 uint8_t iter;
 Wins parallel_play(uint8_t pos1, uint8_t score1, uint8_t pos2, uint8_t score2) {
     // check the memo for result
@@ -94,15 +101,39 @@ Wins parallel_play(uint8_t pos1, uint8_t score1, uint8_t pos2, uint8_t score2) {
     return wins;
 }
 
-int main(void) {
-    init(21);
+AOC64_BUDGET(C64_DATA_RAM, REU_512K, decltype(position), decltype(parallel_memo), decltype(iter), decltype(dice));
+
+// solves the compiled-in starting positions, or those of AOC64_INPUT on the host
+void solve() {
+    uint8_t start[2] = {position[0], position[1]};
+    const uint8_t (*players)[2];
+    size_t n;
+    if (input_numbers(players, n)) {
+        // "Player p starting position: x"
+        assert(n == 2);
+        start[0] = players[0][1];
+        start[1] = players[1][1];
+    }
 
-    printf("part 1: %ld\n", demo_play(position[0], position[1]));
+    phase("part 1");
+    printf("part 1: %ld\n", demo_play(start[0], start[1]));
 
-    // initialize the memoization cache
-    reu_init(); parallel_memo.init(0);
-    Wins res = parallel_play(position[0], 0, position[1], 0);
+    // clear the memoization cache, also of a previous input of a batch
+    phase("part 2");
+    parallel_memo.init(0);
+    const uint32_t dropped = parallel_memo.dropped;
+    Wins res = parallel_play(start[0], 0, start[1], 0);
     printf("part 2: %llu\n", res.wins1 > res.wins2 ? res.wins1 : res.wins2);
+    // states the full memo could not keep (see CacheFront::dropped) were recomputed, the counts are exact anyway
+    if (parallel_memo.dropped != dropped)
+        printf("memo full: %lu states not kept\n", (unsigned long)(parallel_memo.dropped - dropped));
+}
 
+int main(int argc, char** argv) {
+    init(21);
+    reu_init();
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
@@ -3,9 +3,11 @@
 #include "hashset_reu.h"
 #include "hashset.h"
 #include "pearson.h"
+#include "input_file.h"
+#include "batch.h"
 #include <stdint.h>
 #include <string.h>
-#if __has_include("input.h")
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
@@ -21,7 +23,7 @@ struct Cuboid {
     int24_t r[6];
 
     const int64_t volume() const { return (int64_t)sign*(r[1]-r[0]+1)*(r[3]-r[2]+1)*(r[5]-r[4]+1); }
-    const int16_t hash() const { return hash16((uint8_t *)&(r[0]), RANGE_SIZE); }
+    const uint16_t hash() const { return hash16((uint8_t *)&(r[0]), RANGE_SIZE); }
     const int8_t intersection(const Cuboid& other, Cuboid* inter) const;
 };
 
@@ -45,7 +47,7 @@ const int8_t Cuboid::intersection(const Cuboid& other, Cuboid* inter) const {
 
 void parseCuboid(const char* str, Cuboid* c) {
     c->sign = (str[1] == 'n') ? (int8_t)1 : (int8_t)-1;
-    int32_t x0, x1, y0, y1, z0, z1;
+    long x0, x1, y0, y1, z0, z1;
     sscanf(str, " %*s x=%ld..%ld,y=%ld..%ld,z=%ld..%ld", &x0, &x1, &y0, &y1, &z0, &z1);
     c->r[0] = x0; c->r[1] = x1;
     c->r[2] = y0; c->r[3] = y1;
@@ -53,22 +55,34 @@ void parseCuboid(const char* str, Cuboid* c) {
 }
 
 
-int main(void) {
-    init(22);
+AOC64_BUDGET(C64_DATA_RAM, REU_512K, decltype(steps), HashSet<Cuboid, uint16_t, HASHMAP_SIZE>,
+             HashSetREU<Cuboid, uint16_t, HASHMAP_SIZE_REU>, Region<0, 1024>, bool);
 
-    // hash map of cuboids to merge into cuboids after each step
-    HashSet<Cuboid, uint16_t, HASHMAP_SIZE> add_cuboids;
-    // hash map to hold all cuboids generated in previous steps (on the REU)
-    HashSetREU<Cuboid, uint16_t, HASHMAP_SIZE_REU> cuboids;
-    reu_init(); cuboids.init(1024); // initialize the the hash map on the REU
+// hash map of cuboids to merge into cuboids after each step
+static HashSet<Cuboid, uint16_t, HASHMAP_SIZE> add_cuboids;
+// hash map to hold all cuboids generated in previous steps (on the REU)
+static HashSetREU<Cuboid, uint16_t, HASHMAP_SIZE_REU> cuboids;
+
+// solves the compiled-in reboot steps, or those of AOC64_INPUT (or of each input of a batch) on the host
+void solve() {
+    const char* const* reboot = steps;
+    uint16_t n_reboot = nsteps;
+    input_lines(reboot, n_reboot);
+
+    // init() cleared the set for the first input, the next inputs of a batch reuse it
+    static bool reused = false;
+    if (reused)
+        cuboids.clear();
+    reused = true;
 
+    phase("reboot");
     Cuboid new_c, inter;
     uint16_t t = 0;
-    for (uint16_t s = 0; s < nsteps; ++s) {
+    for (uint16_t s = 0; s < n_reboot; ++s) {
         tick(t++ & (uint8_t)7);
         add_cuboids.clear();
         // construct the new cuboid
-        parseCuboid(steps[s], &new_c);
+        parseCuboid(reboot[s], &new_c);
         // if the new cuboid is of the 'on' type, add it as well
         if (new_c.sign > 0)
             add_cuboids.insert(new_c);
@@ -100,6 +114,7 @@ int main(void) {
         }
     }
 
+    phase("volumes");
     int64_t part1 = 0, part2 = 0;
     for (const Cuboid* c = cuboids.first(); c != nullptr; c = cuboids.next()) {
         const int64_t v = c->volume();
@@ -113,6 +128,13 @@ int main(void) {
 
     printf("part 1: %lld\n", part1);
     printf("part 2: %lld\n", part2);
+}
 
+int main(int argc, char** argv) {
+    init(22);
+    reu_init(); cuboids.init(1024); // initialize the the hash map on the REU
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
@@ -2,17 +2,23 @@
 
 #include <stdint.h>
 #include "AoC64.h"
+#include "progress.h"
 #include "stack.h"
 #include "min_heap_reu.h"
 #include "hashmap_reu.h"
 #include "pearson.h"
 #include "math.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
 
+// the compiled-in burrow, or that of AOC64_INPUT on the host (see solve)
+static const char* const* burrow = input;
+
 uint8_t puzzle_size;
 uint8_t room_size;
 
@@ -51,13 +57,23 @@ Stack<uint8_t, uint8_t, 8> _parking;
 struct Move { uint8_t a, b; };
 Stack<Move, uint8_t, 32> _moves;
 static Item _item;
+// open and closed set sizes
+constexpr reu_addr_t offset = 0x100; // skip the bottom 256 bytes of the REU
+constexpr reu_addr_t open_size = 0x5000;
+constexpr reu_addr_t closed_size = 0x40000;
+typedef HeapREU<Item, uint16_t, open_size> OpenSet;
+typedef HashMapREU<Puzzle, uint16_t, reu_addr_t, closed_size> ClosedSet;
+// successors of the popped state, checked against the closed set in one batch
+static Puzzle _succ[32];
+static uint16_t _succ_priority[32];
+static uint8_t _succ_improved[32];
 
 
 void read_puzzle(Puzzle& puzzle, uint8_t part2 = 0) {
     memset(&puzzle.str[0], '.', 11);
     for (uint8_t i = 0; i < 2; ++i)
         for (uint8_t j = 0; j < 4; ++j)
-            puzzle.str[11 + (part2 ? 12 : 4)*i + j] = input[i + 2][3 + 2*j] + 'a' - 'A';
+            puzzle.str[11 + (part2 ? 12 : 4)*i + j] = burrow[i + 2][3 + 2*j] + 'a' - 'A';
     if (!part2) {
         room_size = 2;
         puzzle_size = 20;
@@ -91,12 +107,12 @@ inline void get_possible_parc_pos(const uint8_t a, const Puzzle& puzzle) {
     }
 }
 
-// modifies _item.puzzle
-inline void make_move(const uint8_t a, const uint8_t b, const Puzzle& puzzle) {
-    memcpy_reu(_item.puzzle.str, puzzle.str, puzzle_size);
-    const char tmp = _item.puzzle.str[a];
-    _item.puzzle.str[a] = _item.puzzle.str[b];
-    _item.puzzle.str[b] = tmp;
+// modifies next
+inline void make_move(const uint8_t a, const uint8_t b, const Puzzle& puzzle, Puzzle& next) {
+    memcpy_reu(next.str, puzzle.str, puzzle_size);
+    const char tmp = next.str[a];
+    next.str[a] = next.str[b];
+    next.str[b] = tmp;
 }
 
 
@@ -162,7 +178,7 @@ inline void possible_moves(const Puzzle& puzzle) {
 }
 
 
-uint16_t solve(const Puzzle& puzzle) {
+uint16_t least_energy(const Puzzle& puzzle) {
     Puzzle solution;
     if (puzzle_size > 20)
         solution = "...........abcdabcdabcdabcd";
@@ -170,51 +186,65 @@ uint16_t solve(const Puzzle& puzzle) {
         solution = "...........abcdabcd";
     Item item {0, puzzle};
     // open and closed set ( needs 16MB REU :O )
-    constexpr reu_addr_t offset = 0x100; // skip the bottom 256 bytes of the REU
-    constexpr reu_addr_t open_size = 0x5000;
-    constexpr reu_addr_t closed_size = 0x40000;
-    HeapREU<Item, uint16_t, open_size> open;
-    HashMapREU<Puzzle, uint16_t, reu_addr_t, closed_size> closed;
+    OpenSet open;
+    static ClosedSet closed;
     // push initial state to the open set
     open.init(offset);
     open.push(&item);
     closed.init(offset + open_size*sizeof(open.record));
     // Dijkstra
-    uint8_t t = 0;
+    Progress<4> progress("states");
     while (open.size()) {
         item = open.pop();
         if (item.puzzle == solution)
             return item.priority;
         possible_moves(item.puzzle);
+        uint8_t n = 0;
         while (_moves.size()) {
             Move m = _moves.pop();
             uint8_t parking, room_pos;
             if (m.a < m.b) { parking = m.a; room_pos = m.b; } else { parking = m.b; room_pos = m.a; }
-            make_move(m.a, m.b, item.puzzle); // modifies _item.puzzle
+            make_move(m.a, m.b, item.puzzle, _succ[n]); // modifies _succ[n]
             const uint8_t distance = ABS(stepout[targetI[room_pos]] - parking) + ((room_pos-7) >> 2);
-            const uint16_t new_priority = item.priority + (uint16_t)distance*energy[idx(item.puzzle.str[m.a])];
-            const uint16_t* seen_priority = closed.get(_item.puzzle);
-            if (seen_priority != nullptr && new_priority >= *seen_priority)
+            _succ_priority[n++] = item.priority + (uint16_t)distance*energy[idx(item.puzzle.str[m.a])];
+        }
+        // one probe sweep per successor instead of a get() and an insert()
+        closed.insert_or_improve_batch(_succ, _succ_priority, n, _succ_improved);
+        for (uint8_t j = 0; j < n; ++j) {
+            if (!_succ_improved[j])
                 continue;
-            closed.insert(_item.puzzle, new_priority);
-            _item.priority = new_priority;
+            memcpy_reu(_item.puzzle.str, _succ[j].str, puzzle_size);
+            _item.priority = _succ_priority[j];
             open.push(&_item);
         }
-        tick((++t >> 1) & (uint8_t)7);
+        progress.step();
     }
 
     return 0;
 }
 
 
-int main(void) {
-    init(23);
+AOC64_BUDGET(C64_DATA_RAM, REU_16M, decltype(input), decltype(burrow), decltype(puzzle_size), decltype(room_size), decltype(energy),
+             decltype(parking), decltype(stepout), decltype(target), decltype(targetI), decltype(_parking), decltype(_moves),
+             decltype(_item), decltype(_succ), decltype(_succ_priority), decltype(_succ_improved), OpenSet, ClosedSet, Region<0, offset>);
+
+void solve() {
+    size_t n;
+    input_lines(burrow, n);
 
     Puzzle puzzle;
+    phase("part 1");
     read_puzzle(puzzle);
-    printf("part 1: %u\n", solve(puzzle));
+    printf("part 1: %u\n", least_energy(puzzle));
+    phase("part 2");
     read_puzzle(puzzle, 1);
-    printf("part 2: %u\n", solve(puzzle));
+    printf("part 2: %u\n", least_energy(puzzle));
+}
 
+int main(int argc, char** argv) {
+    init(23);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
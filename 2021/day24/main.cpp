@@ -4,12 +4,17 @@
 #include <stdlib.h>
 #include "AoC64.h"
 #include "stack.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
 #endif
 
+// the compiled-in program, or that of AOC64_INPUT (or of each input of a batch) on the host (see solve)
+static const char* const* monad = program;
+static uint16_t n_monad = n_lines;
 
 struct Digit {
     uint8_t depth;
@@ -18,15 +23,15 @@ struct Digit {
 
 
 // modifies the version number in-place
-char* solve(char* version) {
+char* model_number(char* version) {
     Stack<Digit, uint8_t, 128> stack;
     for (uint8_t i = 0; i < 14; ++i) {
         // parse the parameters from input
         short n1, n2, n3;
         uint8_t ii = 18*i + 4;
-        sscanf(program[ii], "%*s %*s %hd", &n1); ii += 1;
-        sscanf(program[ii], "%*s %*s %hd", &n2); ii += 10;
-        sscanf(program[ii], "%*s %*s %hd", &n3);
+        sscanf(monad[ii], "%*s %*s %hd", &n1); ii += 1;
+        sscanf(monad[ii], "%*s %*s %hd", &n2); ii += 10;
+        sscanf(monad[ii], "%*s %*s %hd", &n3);
         // push 26-ary digit to stack
         if (n1 == 1) {
             stack.push(Digit {i, (uint8_t)n3});
@@ -48,14 +53,30 @@ char* solve(char* version) {
 }
 
 
-int main(void) {
-    init(24);
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(program), decltype(monad), decltype(n_monad), Stack<Digit, uint8_t, 128>);
+
+void solve() {
+    input_lines(monad, n_monad);
+
+    // the example is not a MONAD program (the puzzle has none), 14 blocks of 18 instructions are needed
+    if (n_monad < 18*14) {
+        printf("input is not a MONAD program\n");
+        return;
+    }
 
     char max[15] = "99999999999999";
     char min[15] = "11111111111111";
 
-    printf("part 1: %s\n", solve(max));
-    printf("part 2: %s\n", solve(min));
+    phase("part 1");
+    printf("part 1: %s\n", model_number(max));
+    phase("part 2");
+    printf("part 2: %s\n", model_number(min));
+}
 
+int main(int argc, char** argv) {
+    init(24);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
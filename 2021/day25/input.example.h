@@ -2,14 +2,14 @@
 
 constexpr uint8_t dimx = 10;
 constexpr uint8_t dimy = 9;
-char* const input[dimy] = {
-(char*)"v...>>.vv>",
-(char*)".vv>>.vv..",
-(char*)">>.>v>...v",
-(char*)">>v>>.>.v.",
-(char*)"v>v.vv.v..",
-(char*)">.>>..v...",
-(char*)".vv..>.>v.",
-(char*)"v.v..>>v.v",
-(char*)"....v..v.>"
+char input[dimy][dimx + 1] = {
+"v...>>.vv>",
+".vv>>.vv..",
+">>.>v>...v",
+">>v>>.>.v.",
+"v>v.vv.v..",
+">.>>..v...",
+".vv..>.>v.",
+"v.v..>>v.v",
+"....v..v.>"
 };
\ No newline at end of file
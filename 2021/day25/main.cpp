@@ -1,6 +1,10 @@
+#include <assert.h>
+#include <string.h>
 #include "AoC64.h"
 #include "stack.h"
-#if __has_include("input.h")
+#include "input_file.h"
+#include "batch.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
   #include "input.h"          // user’s private input (gitignored)
 #else
   #include "input.example.h"  // checked-in sample input
@@ -12,12 +16,26 @@ struct Cucumber {
     uint8_t y;
 };
 
-Stack<Cucumber, uint16_t, 5000> cucumbers;
+#ifdef __mos6502__
+// the puzzle's seafloor
+constexpr uint8_t width = dimx, height = dimy;
+constexpr uint8_t MAX_HEIGHT = dimy;
+constexpr uint16_t MAX_MOVES = 5000;
+#else
+// the compiled-in seafloor, or that of AOC64_INPUT (see solve)
+static uint8_t width = dimx, height = dimy;
+constexpr uint8_t MAX_HEIGHT = 255;
+constexpr uint16_t MAX_MOVES = 65535;
+#endif
+// the rows of the seafloor, moved in place
+static char* seafloor[MAX_HEIGHT];
+
+Stack<Cucumber, uint16_t, MAX_MOVES> cucumbers;
 
 
 inline const uint8_t east(const uint8_t x) {
     uint8_t nx = x + 1;
-    if (nx == dimx)
+    if (nx == width)
         return 0;
     return nx;
 }
@@ -25,7 +43,7 @@ inline const uint8_t east(const uint8_t x) {
 
 inline const uint8_t down(const uint8_t y) {
     uint8_t ny = y + 1;
-    if (ny == dimy)
+    if (ny == height)
         return 0;
     return ny;
 }
@@ -34,43 +52,57 @@ inline const uint8_t down(const uint8_t y) {
 int8_t step() {
     // east facing cucumbers
     cucumbers.clear();
-    for (uint8_t i = 0; i < dimy; ++i) {
-        for (uint8_t j = 0; j < dimx; ++j) {
-            if (input[i][j] != '>')
+    for (uint8_t i = 0; i < height; ++i) {
+        for (uint8_t j = 0; j < width; ++j) {
+            if (seafloor[i][j] != '>')
                 continue;
-            if (input[i][east(j)] == '.')
+            if (seafloor[i][east(j)] == '.')
                 cucumbers.push(Cucumber {j, i});
         }
     }
     const uint16_t m1 = cucumbers.size();
     for (uint16_t k = 0; k < m1; ++k) {
         const Cucumber& c = cucumbers.arr[k];
-        input[c.y][c.x] = '.';
-        input[c.y][east(c.x)] = '>';
+        seafloor[c.y][c.x] = '.';
+        seafloor[c.y][east(c.x)] = '>';
     }
     // down facing cucumbers
     cucumbers.clear();
-    for (uint8_t i = 0; i < dimy; ++i) {
-        for (uint8_t j = 0; j < dimx; ++j) {
-            if (input[i][j] != 'v')
+    for (uint8_t i = 0; i < height; ++i) {
+        for (uint8_t j = 0; j < width; ++j) {
+            if (seafloor[i][j] != 'v')
                 continue;
-            if (input[down(i)][j] == '.')
+            if (seafloor[down(i)][j] == '.')
                 cucumbers.push(Cucumber {j, i});
         }
     }
     const uint16_t m2 = cucumbers.size();
     for (uint16_t k = 0; k < m2; ++k) {
         const Cucumber& c = cucumbers.arr[k];
-        input[c.y][c.x] = '.';
-        input[down(c.y)][c.x] = 'v';
+        seafloor[c.y][c.x] = '.';
+        seafloor[down(c.y)][c.x] = 'v';
     }
 
     return m1 > 0 || m2 > 0;
 }
 
 
-int main(void) {
-    init(25);
+AOC64_BUDGET(C64_DATA_RAM, REU_NONE, decltype(input), decltype(seafloor), decltype(cucumbers));
+
+void solve() {
+    for (uint8_t i = 0; i < dimy; ++i)
+        seafloor[i] = input[i];
+#ifndef __mos6502__
+    char* const* lines;
+    size_t n;
+    if (input_lines(lines, n)) {
+        width = strlen(lines[0]);
+        height = n;
+        assert(n <= MAX_HEIGHT && strlen(lines[0]) <= 255);
+        for (uint8_t i = 0; i < height; ++i)
+            seafloor[i] = lines[i];
+    }
+#endif
 
     uint8_t t = 0;
     uint16_t steps = 0;
@@ -79,6 +111,12 @@ int main(void) {
         ++steps;
     } while (step());
     printf("part 1: %d\n", steps);
+}
 
+int main(int argc, char** argv) {
+    init(25);
+    if (!batch(argc, argv, solve))
+        solve();
     finish();
+    return 0;
 }
\ No newline at end of file
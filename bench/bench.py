@@ -0,0 +1,227 @@
+#!/usr/bin/env python3
+"""Runs the host build of every day N times and records its performance.
+
+For each day: min/median/p95 wall time, peak RSS and, for days that use the
+(software) REU, the number of DMA transfers and bytes moved. The last two are
+printed to stderr by the host builds when AOC64_STATS is set. The results are
+written as JSON and/or CSV, compared against a checked-in baseline, and every
+run's part 1/part 2 output is checked against the stored answers.
+
+Exit status is 1 when a day regresses beyond the threshold or gives a wrong
+answer, so the script can be used as a gate.
+
+    cmake -S . -B build && cmake --build build -j
+    bench/bench.py --build-dir build --runs 5 --json bench.json
+"""
+
+import argparse
+import csv
+import hashlib
+import json
+import os
+import re
+import statistics
+import subprocess
+import sys
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+BENCH = os.path.join(ROOT, 'bench')
+PART_RE = re.compile(r'^part (\d+): (.*?)\s*$', re.M)
+REU_RE = re.compile(r'^reu: (\d+) transfers, (\d+) bytes$', re.M)
+RSS_RE = re.compile(r'^rss: (\d+) kB$', re.M)
+README_ROW_RE = re.compile(r'^\|\s*(\d+)\s*\|\s*([\d.]+)\s*\|', re.M)
+FIELDS = ['day', 'input', 'runs', 'min_s', 'median_s', 'p95_s', 'peak_rss_kb',
+          'reu_transfers', 'reu_bytes', 'c64_s', 'baseline_s', 'ratio', 'answers']
+
+
+def percentile(values, p):
+    s = sorted(values)
+    k = (len(s) - 1) * p / 100.0
+    lo = int(k)
+    hi = min(lo + 1, len(s) - 1)
+    return s[lo] + (s[hi] - s[lo]) * (k - lo)
+
+
+def load_json(path, default):
+    if path and os.path.exists(path):
+        with open(path) as f:
+            return json.load(f)
+    return default
+
+
+def example_build(build_dir):
+    """True when the build was configured with AOC64_EXAMPLE_INPUT=ON."""
+    cache = os.path.join(build_dir, 'CMakeCache.txt')
+    if not os.path.exists(cache):
+        return False
+    with open(cache) as f:
+        return re.search(r'^AOC64_EXAMPLE_INPUT:BOOL=(ON|TRUE|1)$', f.read(), re.M) is not None
+
+
+def input_key(day, example):
+    """Identifies the input a day was built with: file name plus a short content hash."""
+    d = os.path.join(ROOT, '2021', day)
+    name = 'input.h' if not example and os.path.exists(os.path.join(d, 'input.h')) else 'input.example.h'
+    with open(os.path.join(d, name), 'rb') as f:
+        return '%s:%s' % (name, hashlib.sha1(f.read()).hexdigest()[:12])
+
+
+def c64_times():
+    """C64 run times (s) from the README table, for reference only."""
+    with open(os.path.join(ROOT, 'README.md')) as f:
+        return {'day%02d' % int(d): float(t) for d, t in README_ROW_RE.findall(f.read())}
+
+
+def run_once(exe):
+    """Runs exe once and reaps it with wait4(), returns (wall s, peak RSS kB, stdout, stderr)."""
+    env = dict(os.environ, AOC64_STATS='1')
+    out_r, out_w = os.pipe()
+    err_r, err_w = os.pipe()
+    start = time.perf_counter()
+    p = subprocess.Popen([exe], stdout=out_w, stderr=err_w, env=env)
+    os.close(out_w)
+    os.close(err_w)
+    with os.fdopen(out_r, 'rb') as fo, os.fdopen(err_r, 'rb') as fe:
+        # outputs are small, read stdout fully before stderr
+        out = fo.read()
+        err = fe.read()
+    _, status, usage = os.wait4(p.pid, 0)
+    wall = time.perf_counter() - start
+    p.returncode = os.waitstatus_to_exitcode(status)
+    if p.returncode != 0:
+        raise RuntimeError('%s exited with %d:\n%s' % (exe, p.returncode, err.decode(errors='replace')))
+    err = err.decode(errors='replace')
+    # prefer the peak RSS reported by the day itself: ru_maxrss also counts the
+    # memory of this (much larger) python process the child was forked from
+    m = RSS_RE.search(err)
+    if m:
+        rss = int(m.group(1))
+    else:
+        # ru_maxrss is in kB on Linux, in bytes on macOS
+        rss = usage.ru_maxrss // 1024 if sys.platform == 'darwin' else usage.ru_maxrss
+    return wall, rss, out.decode(errors='replace'), err
+
+
+def bench_day(exe, runs, warmup):
+    for _ in range(warmup):
+        run_once(exe)
+    walls, rss, outputs, reu = [], 0, set(), None
+    for _ in range(runs):
+        wall, r, out, err = run_once(exe)
+        walls.append(wall)
+        rss = max(rss, r)
+        outputs.add(tuple(PART_RE.findall(out)))
+        m = REU_RE.search(err)
+        if m:
+            reu = (int(m.group(1)), int(m.group(2)))
+    return walls, rss, outputs, reu
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    ap.add_argument('--build-dir', default=os.path.join(ROOT, 'build'))
+    ap.add_argument('--target', default='host', choices=['host', 'host_native'],
+                    help='which host build to run (dayNN_host or dayNN_host_native)')
+    ap.add_argument('--days', help='comma separated day numbers, e.g. 1,15,23 (default: all built days)')
+    ap.add_argument('--runs', type=int, default=5)
+    ap.add_argument('--warmup', type=int, default=1)
+    ap.add_argument('--json', help='write the results to this JSON file')
+    ap.add_argument('--csv', help='write the results to this CSV file')
+    ap.add_argument('--baseline', default=os.path.join(BENCH, 'baseline.json'))
+    ap.add_argument('--threshold', type=float, default=0.25,
+                    help='allowed relative median slowdown against the baseline (default 0.25)')
+    ap.add_argument('--min-delta', type=float, default=0.005,
+                    help='slowdowns below this many seconds are never regressions (timer noise)')
+    ap.add_argument('--update-baseline', action='store_true', help='write the medians as the new baseline')
+    ap.add_argument('--answers', default=os.path.join(BENCH, 'answers.json'))
+    ap.add_argument('--record-answers', action='store_true',
+                    help='store the answers of inputs that have none yet (e.g. a private input.h)')
+    args = ap.parse_args()
+
+    build_dir = os.path.abspath(args.build_dir)
+    example = example_build(build_dir)
+    days = sorted(d for d in os.listdir(os.path.join(ROOT, '2021')) if d.startswith('day'))
+    if args.days:
+        wanted = {'day%02d' % int(d) for d in args.days.split(',')}
+        days = [d for d in days if d in wanted]
+
+    baseline = load_json(args.baseline, {})
+    answers = load_json(args.answers, {})
+    c64 = c64_times()
+    results, failures = [], []
+    answers_changed = False
+
+    for day in days:
+        exe = os.path.join(build_dir, '%s_%s' % (day, args.target))
+        if not os.path.exists(exe):
+            print('%s: %s not built, skipped' % (day, exe), file=sys.stderr)
+            continue
+        key = input_key(day, example)
+        walls, rss, outputs, reu = bench_day(exe, args.runs, args.warmup)
+
+        parts = {p: v for p, v in sorted(outputs)[0]} if outputs else {}
+        status = 'ok'
+        if len(outputs) > 1:
+            status = 'unstable'
+        expected = answers.get(day, {}).get(key)
+        if expected is None:
+            if args.record_answers and status == 'ok':
+                answers.setdefault(day, {})[key] = parts
+                answers_changed = True
+                status = 'recorded'
+            else:
+                status = 'unknown'
+        elif status == 'ok' and parts != expected:
+            status = 'wrong'
+        if status in ('wrong', 'unstable'):
+            failures.append('%s: %s answers %s (expected %s)' % (day, status, parts, expected))
+
+        median = statistics.median(walls)
+        base = baseline.get(args.target, {}).get(day, {}).get(key)
+        ratio = median / base if base else None
+        if base and median - base > max(args.threshold * base, args.min_delta):
+            failures.append('%s: median %.4f s is %.0f%% slower than the baseline %.4f s'
+                            % (day, median, 100 * (ratio - 1), base))
+
+        row = {
+            'day': day, 'input': key, 'runs': len(walls),
+            'min_s': min(walls), 'median_s': median, 'p95_s': percentile(walls, 95),
+            'peak_rss_kb': rss,
+            'reu_transfers': reu[0] if reu else None, 'reu_bytes': reu[1] if reu else None,
+            'c64_s': c64.get(day), 'baseline_s': base, 'ratio': ratio, 'answers': status,
+        }
+        results.append(row)
+        print('%s  min %8.4f  med %8.4f  p95 %8.4f s  rss %7d kB  reu %9s  %s%s'
+              % (day, row['min_s'], median, row['p95_s'], rss,
+                 reu[0] if reu else '-', status,
+                 '  x%.2f' % ratio if ratio else ''))
+
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump({'target': args.target, 'runs': args.runs, 'warmup': args.warmup,
+                       'results': results}, f, indent=2)
+    if args.csv:
+        with open(args.csv, 'w', newline='') as f:
+            w = csv.DictWriter(f, fieldnames=FIELDS)
+            w.writeheader()
+            w.writerows(results)
+    if args.update_baseline:
+        target = baseline.setdefault(args.target, {})
+        for row in results:
+            target.setdefault(row['day'], {})[row['input']] = round(row['median_s'], 6)
+        with open(args.baseline, 'w') as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+            f.write('\n')
+    if answers_changed:
+        with open(args.answers, 'w') as f:
+            json.dump(answers, f, indent=2, sort_keys=True)
+            f.write('\n')
+
+    for msg in failures:
+        print('FAIL ' + msg, file=sys.stderr)
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
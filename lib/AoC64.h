@@ -1,9 +1,21 @@
+#ifndef __AOC64_H__
+#define __AOC64_H__
+
 #include <cstdint>
 #include <cstdio>
 #include <string.h>
+#include "report.h"
+#include "budget.h"
+#include <assert.h>
 
+#ifdef __mos6502__
 typedef _BitInt(24) int24_t;
 typedef unsigned _BitInt(24) uint24_t;
+#else
+// host stand-ins (wider than 24 bits, not every host compiler has _BitInt)
+typedef int32_t int24_t;
+typedef uint32_t uint24_t;
+#endif
 
 #ifdef __mos6502__
 #include <c64.h>
@@ -31,19 +43,22 @@ _KERNAL void _CLRSCR() { _ASM volatile("JSR $E544":::"a","x","y","c"); }
 _KERNAL void _SET_CURSOR(uint8_t y, uint8_t x) {_ASM volatile("CLC\nJSR $FFF0"::"x"(y),"y"(x):"a","c"); }
 
 // returns the JiffyClock (number of jiffies elapsed since boot, 50/s on a PAL and 60/s on a NTSC C64)
-static uint24_t _start_time, _end_time;
 _KERNAL uint24_t get_jiffies() {
     return ((uint24_t)(*(volatile uint8_t*)0x00A0) << 16) |
            ((uint24_t)(*(volatile uint8_t*)0x00A1) <<  8) |
             (uint24_t)(*(volatile uint8_t*)0x00A2);
 }
 
-// calculates the time difference up to 1/100s of a second (precision ~ 20ms for PAL, 17ms for NTSC)
-static inline char* ELAPSED() {
-    static char buffer[10];
-    memset(buffer, 0, 10);
-    const uint32_t elapsed = (_end_time - _start_time) << 1; // time / 50 * 100
-    sprintf(buffer, "%lu.%d", elapsed/100, (uint8_t)elapsed % 100);
+// time stamps and durations are in jiffies
+typedef uint24_t aoc64_time_t;
+static inline aoc64_time_t aoc64_now() { return get_jiffies(); }
+static aoc64_time_t _start_time, _end_time;
+
+// formats a duration in seconds up to 1/100s (precision ~ 20ms for PAL, 17ms for NTSC)
+static inline const char* SECONDS(const aoc64_time_t t) {
+    static char buffer[12];
+    const uint32_t elapsed = (uint32_t)t << 1; // time / 50 * 100
+    sprintf(buffer, "%lu.%02u", elapsed/100, (uint8_t)(elapsed % 100));
     return buffer;
 }
 
@@ -139,23 +154,126 @@ void init(const uint8_t day) {
                             1,  1,  0,  8,  0,  1,  1  };
     blit_petscii(16, 32, 8, 7, code, colr);
 
-    _start_time = get_jiffies();
+    _start_time = aoc64_now();
+}
+
+#else
+#include <stdlib.h>
+#include <chrono>
+
+// time stamps and durations are in nanoseconds
+typedef uint64_t aoc64_time_t;
+static inline aoc64_time_t aoc64_now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+static aoc64_time_t _start_time, _end_time;
+
+// formats a duration in seconds up to 1us
+static inline const char* SECONDS(const aoc64_time_t t) {
+    static char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%.6f", t * 1e-9);
+    return buffer;
+}
+
+// prints the peak resident set size to stderr when AOC64_STATS is set (read by bench/bench.py)
+static inline void _print_host_stats() {
+    if (!getenv("AOC64_STATS"))
+        return;
+    FILE* f = fopen("/proc/self/status", "r");
+    if (f == nullptr)
+        return;
+    char line[128];
+    long kb;
+    while (fgets(line, sizeof(line), f))
+        if (sscanf(line, "VmHWM: %ld kB", &kb) == 1)
+            fprintf(stderr, "rss: %ld kB\n", kb);
+    fclose(f);
+}
+
+void init(const uint8_t day) { _start_time = aoc64_now(); };
+void tick(const uint8_t j) {};
+#endif
+
+
+// Phases (e.g. parse, part 1, part 2) timed separately and printed by finish().
+// Times with the same name add up. Either scoped:
+//     { AOC64_PHASE("parse"); parse_input(); }
+// or sequential, where each phase() ends the previous one (finish() ends the last):
+//     phase("part 1"); ... phase("part 2"); ...
+constexpr uint8_t MAX_PHASES = 8;
+static struct {
+    const char* name[MAX_PHASES];
+    aoc64_time_t total[MAX_PHASES];
+    uint8_t count;
+    uint8_t current;      // running sequential phase (MAX_PHASES if none)
+    aoc64_time_t started; // start of the running sequential phase
+} _phases = {.current = MAX_PHASES};
+
+// The index of the named phase, MAX_PHASES (not timed) when all MAX_PHASES are taken
+static inline uint8_t _phase_index(const char* const name) {
+    for (uint8_t i = 0; i < _phases.count; ++i)
+        if (strcmp(_phases.name[i], name) == 0)
+            return i;
+    if (_phases.count == MAX_PHASES)
+        return MAX_PHASES;
+    _phases.name[_phases.count] = name;
+    _phases.total[_phases.count] = 0;
+    return _phases.count++;
+}
+
+// Scoped phase timer, adds its life time to the named phase
+struct PhaseTimer {
+    const uint8_t i;
+    const aoc64_time_t start;
+    PhaseTimer(const char* const name) : i(_phase_index(name)), start(aoc64_now()) {}
+    ~PhaseTimer() {
+        if (i < MAX_PHASES)
+            _phases.total[i] += aoc64_now() - start;
+    }
+};
+#define _AOC64_CAT2(a, b) a##b
+#define _AOC64_CAT(a, b) _AOC64_CAT2(a, b)
+#define AOC64_PHASE(name) PhaseTimer _AOC64_CAT(_phase_timer_, __LINE__)(name)
+
+// Ends the running sequential phase (if any)
+static inline void end_phase() {
+    if (_phases.current == MAX_PHASES)
+        return;
+    _phases.total[_phases.current] += aoc64_now() - _phases.started;
+    _phases.current = MAX_PHASES;
+}
+
+// Ends the running sequential phase and starts the named one
+static inline void phase(const char* const name) {
+    end_phase();
+    _phases.current = _phase_index(name);
+    _phases.started = aoc64_now();
+}
+
+static inline void _print_phases() {
+    for (uint8_t i = 0; i < _phases.count; ++i)
+        printf("\n  %-8s %s", _phases.name[i], SECONDS(_phases.total[i]));
 }
 
 
 // final state
 void finish() {
-    _end_time = get_jiffies();
+    _end_time = aoc64_now();
+    end_phase();
 
-    printf("\nrun time: %s seconds", ELAPSED());
+    printf("\nrun time: %s seconds", SECONDS(_end_time - _start_time));
+    _print_phases();
+    print_reports();
+#ifdef __mos6502__
 
     /*_SET_CURSOR(12, 13);
     printf("press any key\n");
     _WAIT_KBHIT(); */
+#else
+    printf("\n");
+    _print_host_stats();
+#endif
 }
 
-#else
-void init(const uint8_t day) {};
-void tick(const uint8_t j) {};
-void finish() {};
-#endif
\ No newline at end of file
+#endif // __AOC64_H__
@@ -0,0 +1,92 @@
+#ifndef __BATCH_H__
+#define __BATCH_H__
+
+#include <stdint.h>
+#include "AoC64.h"
+#include "input_file.h"
+
+// Batch mode for the host builds of the days that read their input at run time (input_file.h):
+// one process solves many inputs, without paying the process start and reu_init() for each.
+// The inputs are the file arguments, or with "-" the lines of stdin, either a path or a JSON
+// object with an "input" path ({"input": "alice.txt", ...}), solved as they arrive (server mode).
+// For each input the output of the day is preceded by "== <path>" and followed by its time,
+// finish() prints the total time and the phases added up over all inputs:
+//
+//     build/day22_host alice.txt bob.txt
+//     ls inputs/*.txt | build/day22_host -
+//
+// The day's solver is a function run once per input, the containers it uses live outside of it
+// and are cleared at its start:
+//
+//     int main(int argc, char** argv) {
+//         init(22);
+//         if (!batch(argc, argv, solve))
+//             solve();
+//         finish();
+//         return 0;
+//     }
+#ifdef __mos6502__
+static inline bool batch(int, char**, void (*)()) { return false; }
+#else
+#include <stdio.h>
+#include <string.h>
+
+// Solves the input at path, false if it can't be read
+static bool _batch_solve(const char* const path, void (*const solve)()) {
+    printf("== %s\n", path);
+    if (!input_file_open(path)) {
+        printf("error: cannot read the input\n");
+        return false;
+    }
+    const aoc64_time_t start = aoc64_now();
+    solve();
+    end_phase();
+    printf("time: %s s\n", SECONDS(aoc64_now() - start));
+    fflush(stdout);
+    return true;
+}
+
+// The path of a line of stdin, in place: the line itself, or the "input" string of a JSON object
+static char* _batch_path(char* line) {
+    line[strcspn(line, "\r\n")] = 0;
+    while (*line == ' ' || *line == '\t')
+        ++line;
+    if (*line != '{')
+        return line;
+    char* p = strstr(line, "\"input\"");
+    if (p == nullptr || (p = strchr(p + 7, ':')) == nullptr || (p = strchr(p, '"')) == nullptr)
+        return nullptr;
+    char* const path = ++p;
+    char* q = path;
+    for (; *p && *p != '"'; ++p)
+        *q++ = *p == '\\' && p[1] ? *++p : *p;
+    *q = 0;
+    return path;
+}
+
+// Runs solve for every input given on the command line or stdin, false (nothing done) without arguments
+static bool batch(const int argc, char** const argv, void (*const solve)()) {
+    if (argc < 2)
+        return false;
+    uint32_t solved = 0, failed = 0;
+    if (argc == 2 && strcmp(argv[1], "-") == 0) {
+        char line[4096];
+        while (fgets(line, sizeof(line), stdin)) {
+            char* const path = _batch_path(line);
+            if (path == nullptr) {
+                printf("== ?\nerror: no \"input\" in the JSON line\n");
+                ++failed;
+            } else if (*path) {
+                ++(_batch_solve(path, solve) ? solved : failed);
+            }
+        }
+    } else {
+        for (int i = 1; i < argc; ++i)
+            ++(_batch_solve(argv[i], solve) ? solved : failed);
+    }
+    printf("\nbatch: %lu inputs solved, %lu failed", (unsigned long)solved, (unsigned long)failed);
+    return true;
+}
+#endif
+
+#endif // __BATCH_H__
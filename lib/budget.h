@@ -0,0 +1,86 @@
+#ifndef __BUDGET_H__
+#define __BUDGET_H__
+
+#include <stdint.h>
+
+// Compile-time memory budget of a solution.
+// Containers report their footprint through their static ram_bytes and reu_bytes members,
+// any other type (input arrays, plain structs) counts with its sizeof in RAM.
+// String tables only count their pointers, the literals are part of the code allowance.
+// The check is only active for the C64: the host has other sizes (int, size_t, pointers), padding
+// and capacities (MAX_WIDTH and the like), so its sums would not be the C64's.
+// List every static of the solution, function-local ones by their type.
+// Usage (at namespace scope, after the containers and the input are declared):
+//   AOC64_BUDGET(C64_DATA_RAM, REU_512K, decltype(input), HashMapREU<Key, Value, uint16_t, 20000>);
+
+// RAM of a llvm-mos C64 program ($0801-$CFFF), shared by the code, the input, and the data
+constexpr uint32_t C64_RAM = 0xD000 - 0x0801;
+// Rough allowance for the code, the C stack and the runtime
+constexpr uint32_t C64_CODE = 0x3000;
+// RAM left for the input and the data
+constexpr uint32_t C64_DATA_RAM = C64_RAM - C64_CODE;
+// REU sizes
+constexpr uint32_t REU_NONE = 0;
+constexpr uint32_t REU_128K = 0x20000;
+constexpr uint32_t REU_512K = 0x80000;
+constexpr uint32_t REU_2M = 0x200000;
+constexpr uint32_t REU_16M = 0x1000000;
+
+// Footprint of any type
+template <typename T, typename = void>
+struct Footprint {
+    static const uint32_t ram = sizeof(T);
+    static const uint32_t reu = 0;
+};
+
+// Footprint of a container
+template <typename T>
+struct Footprint<T, decltype((void)T::reu_bytes)> {
+    static const uint32_t ram = T::ram_bytes;
+    static const uint32_t reu = T::reu_bytes;
+};
+
+// Footprint of an array (of containers)
+template <typename T, uint32_t N>
+struct Footprint<T[N], void> {
+    static const uint32_t ram = N*Footprint<T>::ram;
+    static const uint32_t reu = N*Footprint<T>::reu;
+};
+
+// Raw memory region, e.g. local buffers or REU areas used directly with reucpy
+template <uint32_t RAM, uint32_t REU = 0>
+struct Region {
+    static const uint32_t ram_bytes = RAM;
+    static const uint32_t reu_bytes = REU;
+};
+
+// These fail to compile when the budget is exceeded,
+// the instantiation in the error message reads <used bytes, limit bytes, bytes of each part...>
+template <uint32_t USED, uint32_t LIMIT, uint32_t... PARTS>
+struct RAMBudget {
+    static_assert(USED <= LIMIT, "RAM budget exceeded, see RAMBudget<used, limit, parts...>");
+    static const bool ok = true;
+};
+template <uint32_t USED, uint32_t LIMIT, uint32_t... PARTS>
+struct REUBudget {
+    static_assert(USED <= LIMIT, "REU budget exceeded, see REUBudget<used, limit, parts...>");
+    static const bool ok = true;
+};
+
+// The budget of the given types
+template <uint32_t RAM_LIMIT, uint32_t REU_LIMIT, typename... T>
+struct Budget {
+    static const uint32_t ram = (Footprint<T>::ram + ... + 0);
+    static const uint32_t reu = (Footprint<T>::reu + ... + 0);
+    static const bool ok = RAMBudget<ram, RAM_LIMIT, Footprint<T>::ram...>::ok &&
+                           REUBudget<reu, REU_LIMIT, Footprint<T>::reu...>::ok;
+};
+
+#ifdef __mos6502__
+#define AOC64_BUDGET(ram_limit, reu_limit, ...) \
+    static_assert(Budget<ram_limit, reu_limit, __VA_ARGS__>::ok, "memory budget")
+#else
+#define AOC64_BUDGET(ram_limit, reu_limit, ...) static_assert(true, "memory budget")
+#endif
+
+#endif // __BUDGET_H__
@@ -0,0 +1,215 @@
+#ifndef __CACHE_H__
+#define __CACHE_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include "report.h"
+
+// Whether T is void, for the insert() of maps that return nothing
+template <typename T> struct _CacheVoid { static const bool value = false; };
+template <> struct _CacheVoid<void> { static const bool value = true; };
+
+// The cache line structure
+template <typename TKey, typename TItem>
+struct CacheLine {
+    TKey key;
+    TItem item;
+    uint8_t flags;
+};
+
+
+// Small set-associative RAM cache layered in front of a hash map (HashMap, HashMapREU and the cuckoo variants).
+// Hits on hot keys are served from RAM without probing the map (no REU DMA), only found items are cached.
+// Write-through keeps the map up to date on every insert, write-back only writes dirty lines to the map
+// when they are evicted or on flush() (call it before size() or iterating the map).
+// Maps whose insert() can fail (the cuckoo variants return 0 when full) have the failures counted as
+// dropped: the failing insert() returns 0, in write-back mode that of the line whose write-back failed.
+// Statistics are printed at finish().
+// TMap: the wrapped map type, its API is kept as is
+// N_SETS: number of sets (must be a power of 2)
+// WAYS: lines per set, 1 (direct-mapped) or 2 (LRU replacement)
+// WRITE_BACK: defer the map inserts until eviction
+template <typename TMap, typename TKey, typename TItem, uint16_t N_SETS, uint8_t WAYS = 1, bool WRITE_BACK = false>
+struct CacheFront : TMap {
+    // Data
+    CacheLine<TKey, TItem> lines[N_SETS][WAYS];
+    uint8_t lru[N_SETS];
+    static_assert((N_SETS & (N_SETS - 1)) == 0, "Cache sets must be a power of 2");
+    static_assert(WAYS == 1 || WAYS == 2, "Cache must be direct-mapped or 2-way");
+    // Line flags
+    static const uint8_t VALID = 1;
+    static const uint8_t DIRTY = 2;
+    // Statistics
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t write_backs = 0;
+    uint32_t dropped = 0;
+    // Memory footprint (see budget.h)
+    static const uint32_t ram_bytes = TMap::ram_bytes + sizeof(lines) + sizeof(lru) + sizeof(hits) + sizeof(misses) + sizeof(write_backs) + sizeof(dropped);
+    static const uint32_t reu_bytes = TMap::reu_bytes;
+
+    CacheFront() { _invalidate(); at_finish(_report, this); }
+    ~CacheFront() { cancel_reports(this); }
+
+    // Initializes the map (REU variants only) and invalidates the cache
+    template <typename TAddr>
+    void init(const TAddr addr) { _invalidate(); TMap::init(addr); }
+    // Gets an item by key
+    const TItem* get(const TKey& key);
+    // Inserts (or overwrites) a key-item pair, returns 0 when the map had no room for a record
+    int8_t insert(const TKey& key, const TItem& item);
+    // Removes an item by key
+    int8_t remove(const TKey& key);
+    // Writes all dirty lines to the map (write-back only)
+    void flush();
+    // Clears the map and invalidates the cache
+    void clear() { _invalidate(); TMap::clear(); }
+
+    // Internal helpers
+    void _invalidate();
+    static uint16_t _set(const TKey& key) { return key.hash() & (N_SETS - 1); }
+    // returns the line holding the key, or nullptr
+    CacheLine<TKey, TItem>* _lookup(const uint16_t s, const TKey& key);
+    // returns a free line of the set, or evicts the least recently used one (writing it back if dirty),
+    // stored is 0 when the write-back failed
+    CacheLine<TKey, TItem>* _evict(const uint16_t s, int8_t& stored);
+    // inserts into the map, 0 when it failed
+    int8_t _map_insert(const TKey& key, const TItem& item);
+    void _touch(const uint16_t s, const uint8_t w) { if (WAYS == 2) lru[s] = w ^ 1; }
+    static void _report(const void* ctx);
+};
+
+
+template <typename TMap, typename TKey, typename TItem, uint16_t N_SETS, uint8_t WAYS, bool WRITE_BACK>
+void CacheFront<TMap, TKey, TItem, N_SETS, WAYS, WRITE_BACK>::_invalidate() {
+    for (uint16_t s = 0; s < N_SETS; ++s) {
+        for (uint8_t w = 0; w < WAYS; ++w)
+            lines[s][w].flags = 0;
+        lru[s] = 0;
+    }
+}
+
+template <typename TMap, typename TKey, typename TItem, uint16_t N_SETS, uint8_t WAYS, bool WRITE_BACK>
+CacheLine<TKey, TItem>* CacheFront<TMap, TKey, TItem, N_SETS, WAYS, WRITE_BACK>::_lookup(const uint16_t s, const TKey& key) {
+    for (uint8_t w = 0; w < WAYS; ++w) {
+        CacheLine<TKey, TItem>* const line = &lines[s][w];
+        if ((line->flags & VALID) && line->key == key) {
+            _touch(s, w);
+            return line;
+        }
+    }
+    return nullptr;
+}
+
+template <typename TMap, typename TKey, typename TItem, uint16_t N_SETS, uint8_t WAYS, bool WRITE_BACK>
+int8_t CacheFront<TMap, TKey, TItem, N_SETS, WAYS, WRITE_BACK>::_map_insert(const TKey& key, const TItem& item) {
+    int8_t stored = 1;
+    if constexpr (_CacheVoid<decltype(TMap::insert(key, item))>::value)
+        TMap::insert(key, item);
+    else
+        stored = TMap::insert(key, item) != 0;
+    if (!stored)
+        ++dropped;
+    return stored;
+}
+
+template <typename TMap, typename TKey, typename TItem, uint16_t N_SETS, uint8_t WAYS, bool WRITE_BACK>
+CacheLine<TKey, TItem>* CacheFront<TMap, TKey, TItem, N_SETS, WAYS, WRITE_BACK>::_evict(const uint16_t s, int8_t& stored) {
+    uint8_t w = lru[s];
+    if (WAYS == 2 && !(lines[s][w ^ 1].flags & VALID))
+        w ^= 1;
+    CacheLine<TKey, TItem>* const line = &lines[s][w];
+    stored = 1;
+    if (WRITE_BACK && (line->flags & DIRTY)) {
+        stored = _map_insert(line->key, line->item);
+        ++write_backs;
+    }
+    line->flags = 0;
+    _touch(s, w);
+    return line;
+}
+
+// pointer to an internal record; make sure to create a copy of the value if needed!
+template <typename TMap, typename TKey, typename TItem, uint16_t N_SETS, uint8_t WAYS, bool WRITE_BACK>
+const TItem* CacheFront<TMap, TKey, TItem, N_SETS, WAYS, WRITE_BACK>::get(const TKey& key) {
+    const uint16_t s = _set(key);
+    const CacheLine<TKey, TItem>* const hit = _lookup(s, key);
+    if (hit != nullptr) {
+        ++hits;
+        return &hit->item;
+    }
+    ++misses;
+    // absent keys leave the set as it is
+    const TItem* const item = TMap::get(key);
+    if (item == nullptr)
+        return nullptr;
+    // copied before the eviction, the write-back would overwrite the map's record buffer
+    const TItem found = *item;
+    int8_t stored;
+    CacheLine<TKey, TItem>* const line = _evict(s, stored);
+    line->key = key;
+    line->item = found;
+    line->flags = VALID;
+    return &line->item;
+}
+
+template <typename TMap, typename TKey, typename TItem, uint16_t N_SETS, uint8_t WAYS, bool WRITE_BACK>
+int8_t CacheFront<TMap, TKey, TItem, N_SETS, WAYS, WRITE_BACK>::insert(const TKey& key, const TItem& item) {
+    const uint16_t s = _set(key);
+    int8_t stored = 1;
+    CacheLine<TKey, TItem>* line = _lookup(s, key);
+    if (line == nullptr) {
+        line = _evict(s, stored);
+        line->key = key;
+    }
+    line->item = item;
+    if (WRITE_BACK) {
+        line->flags = VALID | DIRTY;
+        return stored;
+    }
+    line->flags = VALID;
+    return _map_insert(key, item);
+}
+
+template <typename TMap, typename TKey, typename TItem, uint16_t N_SETS, uint8_t WAYS, bool WRITE_BACK>
+int8_t CacheFront<TMap, TKey, TItem, N_SETS, WAYS, WRITE_BACK>::remove(const TKey& key) {
+    CacheLine<TKey, TItem>* const line = _lookup(_set(key), key);
+    if (line != nullptr) {
+        // a dirty line may not have reached the map yet
+        const int8_t in_map = TMap::remove(key);
+        const int8_t dirty = line->flags & DIRTY;
+        line->flags = 0;
+        return dirty ? 0 : in_map;
+    }
+    return TMap::remove(key);
+}
+
+template <typename TMap, typename TKey, typename TItem, uint16_t N_SETS, uint8_t WAYS, bool WRITE_BACK>
+void CacheFront<TMap, TKey, TItem, N_SETS, WAYS, WRITE_BACK>::flush() {
+    if (!WRITE_BACK)
+        return;
+    for (uint16_t s = 0; s < N_SETS; ++s) {
+        for (uint8_t w = 0; w < WAYS; ++w) {
+            CacheLine<TKey, TItem>* const line = &lines[s][w];
+            if (line->flags & DIRTY) {
+                _map_insert(line->key, line->item);
+                line->flags = VALID;
+                ++write_backs;
+            }
+        }
+    }
+}
+
+template <typename TMap, typename TKey, typename TItem, uint16_t N_SETS, uint8_t WAYS, bool WRITE_BACK>
+void CacheFront<TMap, TKey, TItem, N_SETS, WAYS, WRITE_BACK>::_report(const void* ctx) {
+    const CacheFront* const c = (const CacheFront*)ctx;
+    const uint32_t lookups = c->hits + c->misses;
+    printf("\ncache: %lu lookups, %lu hits (%u%%)", (unsigned long)lookups, (unsigned long)c->hits,
+           (unsigned)(lookups ? (uint64_t)c->hits*100/lookups : 0));
+    if (WRITE_BACK)
+        printf("\n       %lu write-backs", (unsigned long)c->write_backs);
+    if (c->dropped)
+        printf("\n       %lu dropped (map full)", (unsigned long)c->dropped);
+}
+
+#endif // __CACHE_H__
@@ -0,0 +1,200 @@
+#ifndef __CUCKOO_HASHMAP_H__
+#define __CUCKOO_HASHMAP_H__
+
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+#include "pearson.h"
+
+// The cuckoo hash record structure (same layout as HashMapRecord)
+template <typename TKey, typename TItem>
+struct CuckooRecord {
+    int8_t marker;
+    TKey key;
+    TItem item;
+};
+
+// Returns the second bucket of a key given its first bucket b1 (always != b1).
+// Uses a seeded Pearson hash of the raw key bytes, keys sharing the full hash() would
+// otherwise share both buckets too.
+template <typename TKey, typename IType>
+inline IType _cuckoo_alt(const TKey& key, const IType b1, const IType n_buckets) {
+    const uint8_t* data = (const uint8_t*)&key;
+    uint8_t h1 = 0x55, h2 = 0xaa;
+    for (uint8_t i = 0; i < sizeof(TKey); ++i) {
+        h1 = _T[h1 ^ *data++];
+        h2 = _T[h2 ^ h1];
+    }
+    IType b2 = b1 + 1 + (((uint16_t)h1 << 8) | h2) % (n_buckets - 1);
+    if (b2 >= n_buckets)
+        b2 -= n_buckets;
+    return b2;
+}
+
+
+// The cuckoo hash map structure.
+// Every key lives in one of two buckets of 2 records each (or in a small stash),
+// so a lookup checks at most 4 records and the stash, regardless of the load.
+// TKey: must implement hash() and the == operator, and must not contain padding bytes
+// IType: integer type to be used for index variables
+// MAX_SIZE: number of records (must be even), keep the load below ~75%
+// STASH_SIZE: number of records for keys that could not be placed in the table
+template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE, uint8_t STASH_SIZE = 8>
+struct CuckooHashMap {
+    // Data
+    CuckooRecord<TKey, TItem> records[MAX_SIZE];
+    CuckooRecord<TKey, TItem> stash[STASH_SIZE];
+    static const IType N_BUCKETS = MAX_SIZE / 2;
+    static_assert((MAX_SIZE & 1) == 0, "MAX_SIZE must be even");
+    // Maximum length of the displacement chain before an item goes to the stash
+    static const uint8_t MAX_KICKS = 64;
+    // For marking
+    static const int8_t EMPTY = 0;
+    static const int8_t FULL = 1;
+    // Custom invalid index value
+    static const IType INVALID_INDEX = (IType)-1;
+    // For iteration
+    IType iter_index;
+    // Memory footprint (see budget.h)
+    static const uint32_t ram_bytes = sizeof(records) + sizeof(stash) + sizeof(iter_index);
+    static const uint32_t reu_bytes = 0;
+
+    // Finds an item by key and returns its index (indices >= MAX_SIZE refer to the stash)
+    IType find(const TKey& key) const;
+    // Gets an item by key
+    const TItem* get(const TKey& key) const;
+    // Inserts (or overwrites) a key-item pair, returns 0 (and leaves the map as it is) when it is full
+    int8_t insert(const TKey& key, const TItem& item);
+    // Removes an item by key
+    int8_t remove(const TKey& key);
+    // Returns the number of elements
+    IType size() const;
+    // Clears the map
+    void clear();
+    // Returns the first element
+    const CuckooRecord<TKey, TItem>* first();
+    // Returns the next element
+    const CuckooRecord<TKey, TItem>* next();
+
+    // Internal helpers
+    CuckooRecord<TKey, TItem>* _record(const IType i) { return i < MAX_SIZE ? &records[i] : &stash[i - MAX_SIZE]; }
+    static IType _bucket(const TKey& key) { return key.hash() % N_BUCKETS; }
+    static IType _other_bucket(const TKey& key, const IType b) {
+        const IType b1 = _bucket(key);
+        return b == b1 ? _cuckoo_alt(key, b1, N_BUCKETS) : b1;
+    }
+};
+
+
+template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE, uint8_t STASH_SIZE>
+IType CuckooHashMap<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::find(const TKey& key) const {
+    const IType b1 = _bucket(key);
+    IType i = b1 << 1;
+    if (records[i].marker == FULL && records[i].key == key)
+        return i;
+    if (records[++i].marker == FULL && records[i].key == key)
+        return i;
+    i = _cuckoo_alt(key, b1, N_BUCKETS) << 1;
+    if (records[i].marker == FULL && records[i].key == key)
+        return i;
+    if (records[++i].marker == FULL && records[i].key == key)
+        return i;
+    for (uint8_t s = 0; s < STASH_SIZE; ++s)
+        if (stash[s].marker == FULL && stash[s].key == key)
+            return MAX_SIZE + s;
+    return INVALID_INDEX;
+}
+
+template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE, uint8_t STASH_SIZE>
+const TItem* CuckooHashMap<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::get(const TKey& key) const {
+    const IType i = find(key);
+    if (i == INVALID_INDEX)
+        return nullptr;
+    return i < MAX_SIZE ? &records[i].item : &stash[i - MAX_SIZE].item;
+}
+
+template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE, uint8_t STASH_SIZE>
+int8_t CuckooHashMap<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::insert(const TKey& key, const TItem& item) {
+    IType i = find(key);
+    if (i != INVALID_INDEX) {
+        _record(i)->item = item;
+        return 1;
+    }
+    CuckooRecord<TKey, TItem> cur = {FULL, key, item};
+    IType b = _bucket(key);
+    const IType b2 = _cuckoo_alt(key, b, N_BUCKETS);
+    // free slot in one of the two buckets
+    for (i = b << 1; i < (b << 1) + 2; ++i)
+        if (records[i].marker != FULL) { records[i] = cur; return 1; }
+    for (i = b2 << 1; i < (b2 << 1) + 2; ++i)
+        if (records[i].marker != FULL) { records[i] = cur; return 1; }
+    // displace items along a bounded chain, only with room in the stash for the last one:
+    // a resident item is never dropped
+    uint8_t spare = 0;
+    while (spare < STASH_SIZE && stash[spare].marker == FULL)
+        ++spare;
+    if (spare == STASH_SIZE)
+        return 0;
+    uint8_t victim = 0;
+    for (uint8_t k = 0; k < MAX_KICKS; ++k) {
+        i = (b << 1) + victim;
+        const CuckooRecord<TKey, TItem> tmp = records[i];
+        records[i] = cur;
+        cur = tmp;
+        b = _other_bucket(cur.key, b);
+        for (i = b << 1; i < (b << 1) + 2; ++i)
+            if (records[i].marker != FULL) { records[i] = cur; return 1; }
+        // pseudo-random victim, a strict alternation easily runs into cycles
+        victim = (uint8_t)(cur.key.hash() >> (k & 7)) & 1;
+    }
+    // the last displaced item goes to the stash
+    stash[spare] = cur;
+    return 1;
+}
+
+template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE, uint8_t STASH_SIZE>
+int8_t CuckooHashMap<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::remove(const TKey& key) {
+    const IType i = find(key);
+    if (i == INVALID_INDEX)
+        return -1;
+    _record(i)->marker = EMPTY;
+    return 0;
+}
+
+template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE, uint8_t STASH_SIZE>
+IType CuckooHashMap<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::size() const {
+    IType l = 0;
+    for (IType i = 0; i < MAX_SIZE; ++i)
+        if (records[i].marker == FULL)
+            ++l;
+    for (uint8_t s = 0; s < STASH_SIZE; ++s)
+        if (stash[s].marker == FULL)
+            ++l;
+    return l;
+}
+
+template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE, uint8_t STASH_SIZE>
+void CuckooHashMap<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::clear() {
+    for (IType i = 0; i < MAX_SIZE; ++i)
+        records[i].marker = EMPTY;
+    for (uint8_t s = 0; s < STASH_SIZE; ++s)
+        stash[s].marker = EMPTY;
+}
+
+template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE, uint8_t STASH_SIZE>
+const CuckooRecord<TKey, TItem>* CuckooHashMap<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::first() {
+    iter_index = INVALID_INDEX;
+    return next();
+}
+
+template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE, uint8_t STASH_SIZE>
+const CuckooRecord<TKey, TItem>* CuckooHashMap<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::next() {
+    for (++iter_index; iter_index < MAX_SIZE + STASH_SIZE; ++iter_index) {
+        const CuckooRecord<TKey, TItem>* const r = _record(iter_index);
+        if (r->marker == FULL)
+            return r;
+    }
+    return nullptr;
+}
+
+#endif //__CUCKOO_HASHMAP_H__
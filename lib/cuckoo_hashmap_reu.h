@@ -0,0 +1,227 @@
+#ifndef __CUCKOO_HASHMAP_REU_H__
+#define __CUCKOO_HASHMAP_REU_H__
+
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+#include "reucpy.h"
+#include "cuckoo_hashmap.h"
+
+
+// The cuckoo hash map structure implemented on the REU.
+// Every key lives in one of two buckets of 2 records each (or in a small RAM stash),
+// so a lookup costs at most 2 DMAs regardless of the load, and an insert a bounded number.
+// TKey: must implement hash() and the == operator, and must not contain padding bytes
+// IType: integer type to be used for index variables
+// MAX_SIZE: number of records (must be even), keep the load below ~75%
+// STASH_SIZE: number of records kept in RAM for keys that could not be placed in the table
+// before use call the init(base_addr) member function
+template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE, uint8_t STASH_SIZE = 8>
+struct CuckooHashMapREU {
+    // Data
+    reu_addr_t base_addr;
+    reu_addr_t end_addr;
+    CuckooRecord<TKey, TItem> bucket[2];
+    CuckooRecord<TKey, TItem> stash[STASH_SIZE];
+    // Memory sizes
+    static const uint16_t record_size = (uint16_t)sizeof(CuckooRecord<TKey, TItem>);
+    static const uint16_t bucket_size = 2*record_size;
+    static const reu_addr_t memory_size = (reu_addr_t)MAX_SIZE*record_size;
+    static const IType N_BUCKETS = MAX_SIZE / 2;
+    static_assert((MAX_SIZE & 1) == 0, "MAX_SIZE must be even");
+    // Maximum length of the displacement chain before an item goes to the stash
+    static const uint8_t MAX_KICKS = 64;
+    // For marking
+    static const int8_t EMPTY = 0;
+    static const int8_t FULL = 1;
+    // Custom invalid index value
+    static const IType INVALID_INDEX = (IType)-1;
+    // For iteration
+    IType iter_index;
+    // Memory footprint (see budget.h)
+    static const uint32_t ram_bytes = sizeof(base_addr) + sizeof(end_addr) + sizeof(bucket) + sizeof(stash) + sizeof(iter_index);
+    static const uint32_t reu_bytes = memory_size;
+
+    // Initializes the map on the REU, needs to be called before first use
+    void init(reu_addr_t addr);
+    // Finds an item by key and returns its index (indices >= MAX_SIZE refer to the stash)
+    IType find(const TKey& key);
+    // Gets an item by key
+    const TItem* get(const TKey& key);
+    // Inserts (or overwrites) a key-item pair, returns 0 (and leaves the map as it is) when it is full
+    int8_t insert(const TKey& key, const TItem& item);
+    // Removes an item by key
+    int8_t remove(const TKey& key);
+    // Returns the number of elements
+    IType size();
+    // clears the REU memory in 64KB blocks (potential for spill over!) and the stash
+    void clear();
+    // Returns the first element
+    const CuckooRecord<TKey, TItem>* first();
+    // Returns the next element
+    const CuckooRecord<TKey, TItem>* next();
+
+    // Internal helpers, can also be used for performance hacks
+    reu_addr_t _get_addr(const IType b) const { return base_addr + (reu_addr_t)bucket_size*b; }
+    void _get_bucket(const IType b) { reucpy((void *)bucket, _get_addr(b), bucket_size, REU2RAM); }
+    void _set_slot(const IType b, const uint8_t s) const {
+        reucpy((void *)&bucket[s], _get_addr(b) + (s ? record_size : 0), record_size, RAM2REU);
+    }
+    // place the record into a free slot of the loaded bucket b, returns 0 if the bucket is full
+    uint8_t _place(const IType b, const CuckooRecord<TKey, TItem>& r);
+    static IType _bucket(const TKey& key) { return key.hash() % N_BUCKETS; }
+    static IType _other_bucket(const TKey& key, const IType b) {
+        const IType b1 = _bucket(key);
+        return b == b1 ? _cuckoo_alt(key, b1, N_BUCKETS) : b1;
+    }
+};
+
+
+template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE, uint8_t STASH_SIZE>
+void CuckooHashMapREU<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::init(reu_addr_t addr) {
+    base_addr = addr;
+    end_addr = addr + memory_size;
+    clear();
+}
+
+template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE, uint8_t STASH_SIZE>
+void CuckooHashMapREU<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::clear() {
+    for (reu_addr_t addr = base_addr; addr < end_addr; addr += (reu_addr_t)0x10000)
+        reuset((reu_addr_t)addr, 0, 0);
+    for (uint8_t s = 0; s < STASH_SIZE; ++s)
+        stash[s].marker = EMPTY;
+}
+
+// leaves the second bucket of the key loaded if the key is not in the table
+template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE, uint8_t STASH_SIZE>
+IType CuckooHashMapREU<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::find(const TKey& key) {
+    const IType b1 = _bucket(key);
+    _get_bucket(b1);
+    if (bucket[0].marker == FULL && bucket[0].key == key)
+        return b1 << 1;
+    if (bucket[1].marker == FULL && bucket[1].key == key)
+        return (b1 << 1) + 1;
+    const IType b2 = _cuckoo_alt(key, b1, N_BUCKETS);
+    _get_bucket(b2);
+    if (bucket[0].marker == FULL && bucket[0].key == key)
+        return b2 << 1;
+    if (bucket[1].marker == FULL && bucket[1].key == key)
+        return (b2 << 1) + 1;
+    for (uint8_t s = 0; s < STASH_SIZE; ++s)
+        if (stash[s].marker == FULL && stash[s].key == key)
+            return MAX_SIZE + s;
+    return INVALID_INDEX;
+}
+
+// pointer to an internal record; make sure to create a copy of the value if needed!
+template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE, uint8_t STASH_SIZE>
+const TItem* CuckooHashMapREU<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::get(const TKey& key) {
+    const IType i = find(key);
+    if (i == INVALID_INDEX)
+        return nullptr;
+    return i < MAX_SIZE ? &bucket[i & 1].item : &stash[i - MAX_SIZE].item;
+}
+
+template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE, uint8_t STASH_SIZE>
+uint8_t CuckooHashMapREU<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::_place(const IType b, const CuckooRecord<TKey, TItem>& r) {
+    for (uint8_t s = 0; s < 2; ++s) {
+        if (bucket[s].marker != FULL) {
+            bucket[s] = r;
+            _set_slot(b, s);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE, uint8_t STASH_SIZE>
+int8_t CuckooHashMapREU<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::insert(const TKey& key, const TItem& item) {
+    IType i = find(key);
+    if (i != INVALID_INDEX) {
+        if (i < MAX_SIZE) {
+            bucket[i & 1].item = item;
+            _set_slot(i >> 1, i & 1);
+        } else
+            stash[i - MAX_SIZE].item = item;
+        return 1;
+    }
+    CuckooRecord<TKey, TItem> cur = {FULL, key, item};
+    // find() left the second bucket loaded, try it first
+    IType b = _bucket(key);
+    if (_place(_cuckoo_alt(key, b, N_BUCKETS), cur))
+        return 1;
+    _get_bucket(b);
+    if (_place(b, cur))
+        return 1;
+    // displace items along a bounded chain, starting from the (loaded) first bucket, only with
+    // room in the stash for the last one: a resident item is never dropped
+    uint8_t spare = 0;
+    while (spare < STASH_SIZE && stash[spare].marker == FULL)
+        ++spare;
+    if (spare == STASH_SIZE)
+        return 0;
+    uint8_t victim = 0;
+    for (uint8_t k = 0; k < MAX_KICKS; ++k) {
+        const CuckooRecord<TKey, TItem> tmp = bucket[victim];
+        bucket[victim] = cur;
+        _set_slot(b, victim);
+        cur = tmp;
+        b = _other_bucket(cur.key, b);
+        _get_bucket(b);
+        if (_place(b, cur))
+            return 1;
+        // pseudo-random victim, a strict alternation easily runs into cycles
+        victim = (uint8_t)(cur.key.hash() >> (k & 7)) & 1;
+    }
+    // the last displaced item goes to the stash
+    stash[spare] = cur;
+    return 1;
+}
+
+template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE, uint8_t STASH_SIZE>
+int8_t CuckooHashMapREU<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::remove(const TKey& key) {
+    const IType i = find(key);
+    if (i == INVALID_INDEX)
+        return -1;
+    if (i < MAX_SIZE) {
+        bucket[i & 1].marker = EMPTY;
+        _set_slot(i >> 1, i & 1);
+    } else
+        stash[i - MAX_SIZE].marker = EMPTY;
+    return 0;
+}
+
+template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE, uint8_t STASH_SIZE>
+IType CuckooHashMapREU<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::size() {
+    IType l = 0;
+    for (IType b = 0; b < N_BUCKETS; ++b) {
+        _get_bucket(b);
+        l += (bucket[0].marker == FULL) + (bucket[1].marker == FULL);
+    }
+    for (uint8_t s = 0; s < STASH_SIZE; ++s)
+        if (stash[s].marker == FULL)
+            ++l;
+    return l;
+}
+
+template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE, uint8_t STASH_SIZE>
+const CuckooRecord<TKey, TItem>* CuckooHashMapREU<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::first() {
+    iter_index = INVALID_INDEX;
+    return next();
+}
+
+template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE, uint8_t STASH_SIZE>
+const CuckooRecord<TKey, TItem>* CuckooHashMapREU<TKey, TItem, IType, MAX_SIZE, STASH_SIZE>::next() {
+    for (++iter_index; iter_index < MAX_SIZE; ++iter_index) {
+        if ((iter_index & 1) == 0)
+            _get_bucket(iter_index >> 1);
+        if (bucket[iter_index & 1].marker == FULL)
+            return &bucket[iter_index & 1];
+    }
+    for (; iter_index < MAX_SIZE + STASH_SIZE; ++iter_index)
+        if (stash[iter_index - MAX_SIZE].marker == FULL)
+            return &stash[iter_index - MAX_SIZE];
+    return nullptr;
+}
+
+#endif //__CUCKOO_HASHMAP_REU_H__
@@ -4,6 +4,7 @@
 #include <assert.h>
 #include <string.h>
 #include <stdint.h>
+#include "instrument.h"
 
 
 // The hash set structure
@@ -21,6 +22,13 @@ struct HashMap {
     static const int8_t TOMBSTONE = -1;
     // Custom invalid index value
     static const IType INVALID_INDEX = (IType)-1;
+    // Maximum number of keys in a batch
+    static const uint8_t MAX_BATCH = 32;
+    // Memory footprint (see budget.h)
+    static const uint32_t ram_bytes = sizeof(keys) + sizeof(items) + sizeof(marker);
+    static const uint32_t reu_bytes = 0;
+    // Statistics (see instrument.h)
+    AOC64_STATS("HashMap", MAX_SIZE, "probe")
 
     // members
     // Finds an item by key and returns its index
@@ -34,14 +42,30 @@ struct HashMap {
     // Returns the number of elements
     IType size() const;
     // Clears the map (marker array only for performance)
-    void clear() { memset(marker, EMPTY, MAX_SIZE); }
+    void clear() { memset(marker, EMPTY, MAX_SIZE); AOC64_STAT(op(STAT_CLEAR)); AOC64_STAT(size(0)); }
+    // Gets a batch of items by key into out, found[j] flags the hits, returns the number of hits
+    uint8_t get_batch(const TKey* keys, const uint8_t n, TItem* out, uint8_t* found) const;
+    // Inserts the key-item pairs that are new or whose item is smaller (operator <) than the stored one,
+    // improved[j] flags the inserted pairs, returns their number
+    uint8_t insert_or_improve_batch(const TKey* keys, const TItem* items, const uint8_t n, uint8_t* improved);
 
     void print(const char* name) const;
+
+    // Internal helpers
+    // hashes all keys of a batch into slot, and sorts their order by slot for a single sweep
+    static void _sort_batch(const TKey* keys, const uint8_t n, IType* slot, uint8_t* order);
+    void _prefetch(const IType i) const {
+#ifndef __mos6502__
+        __builtin_prefetch(&marker[i]);
+        __builtin_prefetch(&keys[i]);
+#endif
+    }
 };
 
 
 template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE>
 IType HashMap<TKey, TItem, IType, MAX_SIZE>::find(const TKey& key) const {
+    AOC64_STAT_RUN(STAT_FIND);
     const IType i0 = key.hash() % MAX_SIZE;
     IType i = i0;
     do {
@@ -49,6 +73,7 @@ IType HashMap<TKey, TItem, IType, MAX_SIZE>::find(const TKey& key) const {
             return i;
         if (marker[i] == EMPTY)
             return INVALID_INDEX;
+        AOC64_STAT(step());
         if (++i == MAX_SIZE)
             i = 0;
     } while (i != i0);
@@ -65,6 +90,7 @@ const TItem* HashMap<TKey, TItem, IType, MAX_SIZE>::get(const TKey& key) const {
 
 template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE>
 void HashMap<TKey, TItem, IType, MAX_SIZE>::insert(const TKey& key, const TItem& item) {
+    AOC64_STAT_RUN(STAT_INSERT);
     const IType i0 = key.hash() % MAX_SIZE;
     IType i = i0;
     IType tombstone = INVALID_INDEX;
@@ -75,6 +101,7 @@ void HashMap<TKey, TItem, IType, MAX_SIZE>::insert(const TKey& key, const TItem&
         }
         if (marker[i] == TOMBSTONE && tombstone == INVALID_INDEX)
             tombstone = i;
+        AOC64_STAT(step());
         if (++i == MAX_SIZE)
             i = 0;
         if (i == i0) {
@@ -88,14 +115,17 @@ void HashMap<TKey, TItem, IType, MAX_SIZE>::insert(const TKey& key, const TItem&
     keys[i] = key;
     items[i] = item;
     marker[i] = FULL;
+    AOC64_STAT(grow());
 }
 
 template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE>
 int8_t HashMap<TKey, TItem, IType, MAX_SIZE>::remove(const TKey& key) {
+    AOC64_STAT(op(STAT_REMOVE));
     const IType i = find(key);
     if (i == INVALID_INDEX)
         return -1;
     marker[i] = TOMBSTONE;
+    AOC64_STAT(shrink());
     return 0;
 }
 
@@ -108,4 +138,91 @@ IType HashMap<TKey, TItem, IType, MAX_SIZE>::size() const {
     return l;
 }
 
+template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE>
+void HashMap<TKey, TItem, IType, MAX_SIZE>::_sort_batch(const TKey* keys, const uint8_t n, IType* slot, uint8_t* order) {
+    assert(n <= MAX_BATCH);
+    for (uint8_t j = 0; j < n; ++j) {
+        slot[j] = keys[j].hash() % MAX_SIZE;
+        // insertion sort, batches are small
+        uint8_t k = j;
+        for (; k > 0 && slot[order[k - 1]] > slot[j]; --k)
+            order[k] = order[k - 1];
+        order[k] = j;
+    }
+}
+
+template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE>
+uint8_t HashMap<TKey, TItem, IType, MAX_SIZE>::get_batch(const TKey* batch_keys, const uint8_t n, TItem* out, uint8_t* found) const {
+    IType slot[MAX_BATCH];
+    uint8_t order[MAX_BATCH];
+    _sort_batch(batch_keys, n, slot, order);
+    uint8_t hits = 0;
+    for (uint8_t k = 0; k < n; ++k) {
+        if (k + 1 < n)
+            _prefetch(slot[order[k + 1]]);
+        const uint8_t j = order[k];
+        AOC64_STAT_RUN(STAT_FIND);
+        found[j] = 0;
+        IType i = slot[j];
+        do {
+            if (marker[i] == FULL && keys[i] == batch_keys[j]) {
+                out[j] = items[i];
+                found[j] = 1;
+                ++hits;
+                break;
+            }
+            if (marker[i] == EMPTY)
+                break;
+            AOC64_STAT(step());
+            if (++i == MAX_SIZE)
+                i = 0;
+        } while (i != slot[j]);
+    }
+    return hits;
+}
+
+template <typename TKey, typename TItem, typename IType, uint16_t MAX_SIZE>
+uint8_t HashMap<TKey, TItem, IType, MAX_SIZE>::insert_or_improve_batch(const TKey* batch_keys, const TItem* batch_items, const uint8_t n, uint8_t* improved) {
+    IType slot[MAX_BATCH];
+    uint8_t order[MAX_BATCH];
+    _sort_batch(batch_keys, n, slot, order);
+    uint8_t count = 0;
+    for (uint8_t k = 0; k < n; ++k) {
+        if (k + 1 < n)
+            _prefetch(slot[order[k + 1]]);
+        const uint8_t j = order[k];
+        AOC64_STAT_RUN(STAT_INSERT);
+        improved[j] = 0;
+        IType i = slot[j];
+        IType tombstone = INVALID_INDEX;
+        while (marker[i] != EMPTY) {
+            if (marker[i] == FULL && keys[i] == batch_keys[j])
+                break;
+            if (marker[i] == TOMBSTONE && tombstone == INVALID_INDEX)
+                tombstone = i;
+            AOC64_STAT(step());
+            if (++i == MAX_SIZE)
+                i = 0;
+            if (i == slot[j]) {
+                assert(tombstone != INVALID_INDEX);
+                break;
+            }
+        }
+        if (marker[i] == FULL && keys[i] == batch_keys[j]) {
+            if (!(batch_items[j] < items[i]))
+                continue;
+        } else {
+            if (tombstone != INVALID_INDEX)
+                i = tombstone;
+            keys[i] = batch_keys[j];
+            marker[i] = FULL;
+            AOC64_STAT(grow());
+        }
+        items[i] = batch_items[j];
+        improved[j] = 1;
+        ++count;
+    }
+    return count;
+}
+
 #endif //__HASHMAP_H__
\ No newline at end of file
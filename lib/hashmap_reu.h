@@ -5,6 +5,7 @@
 #include <string.h>
 #include <stdint.h>
 #include "reucpy.h"
+#include "instrument.h"
 
 // the has record structure
 // TKey: must implement IType hash() and the == operator
@@ -36,8 +37,15 @@ struct HashMapREU {
     static const int8_t TOMBSTONE = -1;
     // Custom invalid index value
     static const IType INVALID_INDEX = (IType)-1;
+    // Maximum number of keys in a batch
+    static const uint8_t MAX_BATCH = 32;
     // For iteration
     IType iter_index;
+    // Memory footprint (see budget.h)
+    static const uint32_t ram_bytes = sizeof(base_addr) + sizeof(end_addr) + sizeof(record) + sizeof(iter_index);
+    static const uint32_t reu_bytes = memory_size;
+    // Statistics (see instrument.h)
+    AOC64_STATS("HashMapREU", MAX_SIZE, "probe")
 
     // Initializes the map on the REU, needs to be called before first use
     void init(reu_addr_t addr);
@@ -57,6 +65,11 @@ struct HashMapREU {
     const HashMapRecord<TKey, TItem>* first();
     // Returns the next element
     const HashMapRecord<TKey, TItem>* next();
+    // Gets a batch of items by key into out, found[j] flags the hits, returns the number of hits
+    uint8_t get_batch(const TKey* keys, const uint8_t n, TItem* out, uint8_t* found);
+    // Inserts the key-item pairs that are new or whose item is smaller (operator <) than the stored one,
+    // improved[j] flags the inserted pairs, returns their number
+    uint8_t insert_or_improve_batch(const TKey* keys, const TItem* items, const uint8_t n, uint8_t* improved);
 
     // Internal helpers, can also be used for performance hacks
     reu_addr_t _get_addr(const IType i) const { return base_addr + (reu_addr_t)record_size*i; }
@@ -64,6 +77,15 @@ struct HashMapREU {
     void _set_record(const IType i) const;
     void _get_record_marker(const IType i);
     void _set_record_marker(const IType i) const;
+    // hashes all keys of a batch into slot, and sorts their order by slot for a single sweep
+    static void _sort_batch(const TKey* keys, const uint8_t n, IType* slot, uint8_t* order);
+    // fetches record i unless it is the one already loaded
+    void _get_record_cached(const IType i, IType& loaded) {
+        if (i != loaded) {
+            _get_record(i);
+            loaded = i;
+        }
+    }
 };
 
 
@@ -76,12 +98,17 @@ void HashMapREU<TKey, TItem, IType, MAX_SIZE>::init(reu_addr_t addr) {
 
 template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE>
 void HashMapREU<TKey, TItem, IType, MAX_SIZE>::clear() const {
-    for (reu_addr_t addr = base_addr; addr < end_addr; addr += (reu_addr_t)0x10000)
+    for (reu_addr_t addr = base_addr; addr < end_addr; addr += (reu_addr_t)0x10000) {
         reuset((reu_addr_t)addr, 0, 0);
+        AOC64_STAT(reu(0x10000));
+    }
+    AOC64_STAT(op(STAT_CLEAR));
+    AOC64_STAT(size(0));
 };
 
 template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE>
 IType HashMapREU<TKey, TItem, IType, MAX_SIZE>::find(const TKey& key) {
+    AOC64_STAT_RUN(STAT_FIND);
     const IType i0 = key.hash() % MAX_SIZE;
     IType i = i0;
     do {
@@ -90,6 +117,7 @@ IType HashMapREU<TKey, TItem, IType, MAX_SIZE>::find(const TKey& key) {
             return i;
         if (record.marker == EMPTY)
             return INVALID_INDEX;
+        AOC64_STAT(step());
         if (++i == MAX_SIZE)
             i = 0;
     } while (i != i0);
@@ -107,6 +135,7 @@ const TItem* HashMapREU<TKey, TItem, IType, MAX_SIZE>::get(const TKey& key) {
 
 template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE>
 void HashMapREU<TKey, TItem, IType, MAX_SIZE>::insert(const TKey& key, const TItem& item) {
+    AOC64_STAT_RUN(STAT_INSERT);
     const IType i0 = key.hash() % MAX_SIZE;
     IType i = i0;
     IType tombstone = INVALID_INDEX;
@@ -119,6 +148,7 @@ void HashMapREU<TKey, TItem, IType, MAX_SIZE>::insert(const TKey& key, const TIt
         }
         if (record.marker == TOMBSTONE && tombstone == INVALID_INDEX)
             tombstone = i;
+        AOC64_STAT(step());
         if (++i == MAX_SIZE)
             i = 0;
         if (i == i0) {
@@ -134,16 +164,19 @@ void HashMapREU<TKey, TItem, IType, MAX_SIZE>::insert(const TKey& key, const TIt
     record.key = key;
     record.item = item;
     _set_record(i);
+    AOC64_STAT(grow());
 }
 
 template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE>
 int8_t HashMapREU<TKey, TItem, IType, MAX_SIZE>::remove(const TKey& key) {
+    AOC64_STAT(op(STAT_REMOVE));
     const IType i = find(key);
     if (i == INVALID_INDEX)
         return -1;
 
     record.marker = TOMBSTONE;
     _set_record(i);
+    AOC64_STAT(shrink());
     return 0;
 }
 
@@ -161,21 +194,25 @@ IType HashMapREU<TKey, TItem, IType, MAX_SIZE>::size() {
 template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE>
 void HashMapREU<TKey, TItem, IType, MAX_SIZE>::_get_record(const IType i) {
     reucpy((void *)&(record), _get_addr(i), record_size, REU2RAM);
+    AOC64_STAT(reu(record_size));
 }
 
 template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE>
 void HashMapREU<TKey, TItem, IType, MAX_SIZE>::_set_record(const IType i) const {
     reucpy((void *)&(record), _get_addr(i), record_size, RAM2REU);
+    AOC64_STAT(reu(record_size));
 }
 
 template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE>
 void HashMapREU<TKey, TItem, IType, MAX_SIZE>::_get_record_marker(const IType i) {
     reucpy((void *)&(record.marker), _get_addr(i), 1, REU2RAM);
+    AOC64_STAT(reu(1));
 }
 
 template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE>
 void HashMapREU<TKey, TItem, IType, MAX_SIZE>::_set_record_marker(const IType i) const {
     reucpy((void *)&(record.marker), _get_addr(i), 1, RAM2REU);
+    AOC64_STAT(reu(1));
 }
 
 template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE>
@@ -200,4 +237,96 @@ const HashMapRecord<TKey, TItem>* HashMapREU<TKey, TItem, IType, MAX_SIZE>::next
     return nullptr;
 }
 
+template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE>
+void HashMapREU<TKey, TItem, IType, MAX_SIZE>::_sort_batch(const TKey* keys, const uint8_t n, IType* slot, uint8_t* order) {
+    assert(n <= MAX_BATCH);
+    for (uint8_t j = 0; j < n; ++j) {
+        slot[j] = keys[j].hash() % MAX_SIZE;
+        // insertion sort, batches are small
+        uint8_t k = j;
+        for (; k > 0 && slot[order[k - 1]] > slot[j]; --k)
+            order[k] = order[k - 1];
+        order[k] = j;
+    }
+}
+
+// keys landing on the same slots share the record fetches
+template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE>
+uint8_t HashMapREU<TKey, TItem, IType, MAX_SIZE>::get_batch(const TKey* keys, const uint8_t n, TItem* out, uint8_t* found) {
+    IType slot[MAX_BATCH];
+    uint8_t order[MAX_BATCH];
+    _sort_batch(keys, n, slot, order);
+    IType loaded = INVALID_INDEX;
+    uint8_t hits = 0;
+    for (uint8_t k = 0; k < n; ++k) {
+        const uint8_t j = order[k];
+        AOC64_STAT_RUN(STAT_FIND);
+        found[j] = 0;
+        IType i = slot[j];
+        do {
+            _get_record_cached(i, loaded);
+            if (record.marker == FULL && record.key == keys[j]) {
+                out[j] = record.item;
+                found[j] = 1;
+                ++hits;
+                break;
+            }
+            if (record.marker == EMPTY)
+                break;
+            AOC64_STAT(step());
+            if (++i == MAX_SIZE)
+                i = 0;
+        } while (i != slot[j]);
+    }
+    return hits;
+}
+
+// a single probe sweep per key replaces the get() and insert() pair
+template <typename TKey, typename TItem, typename IType, uint32_t MAX_SIZE>
+uint8_t HashMapREU<TKey, TItem, IType, MAX_SIZE>::insert_or_improve_batch(const TKey* keys, const TItem* items, const uint8_t n, uint8_t* improved) {
+    IType slot[MAX_BATCH];
+    uint8_t order[MAX_BATCH];
+    _sort_batch(keys, n, slot, order);
+    IType loaded = INVALID_INDEX;
+    uint8_t count = 0;
+    for (uint8_t k = 0; k < n; ++k) {
+        const uint8_t j = order[k];
+        AOC64_STAT_RUN(STAT_INSERT);
+        improved[j] = 0;
+        IType i = slot[j];
+        IType tombstone = INVALID_INDEX;
+        _get_record_cached(i, loaded);
+        while (record.marker != EMPTY) {
+            if (record.marker == FULL && record.key == keys[j])
+                break;
+            if (record.marker == TOMBSTONE && tombstone == INVALID_INDEX)
+                tombstone = i;
+            AOC64_STAT(step());
+            if (++i == MAX_SIZE)
+                i = 0;
+            if (i == slot[j]) {
+                assert(tombstone != INVALID_INDEX);
+                break;
+            }
+            _get_record_cached(i, loaded);
+        }
+        if (record.marker == FULL && record.key == keys[j]) {
+            if (!(items[j] < record.item))
+                continue;
+        } else {
+            if (tombstone != INVALID_INDEX)
+                i = tombstone;
+            record.marker = FULL;
+            record.key = keys[j];
+            AOC64_STAT(grow());
+        }
+        record.item = items[j];
+        _set_record(i);
+        loaded = i;
+        improved[j] = 1;
+        ++count;
+    }
+    return count;
+}
+
 #endif //__HASHMAP_REU_H__
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <assert.h>
 #include <string.h>
 #include <stdint.h>
+#include "instrument.h"
 
 // The hash set structure.
 // T: must implement IType hash() and the == operator
@@ -21,6 +22,11 @@ struct HashSet {
     static const int8_t TOMBSTONE = -1;
     // For iteration
     IType iter_index;
+    // Memory footprint (see budget.h)
+    static const uint32_t ram_bytes = sizeof(data) + sizeof(marker) + sizeof(iter_index);
+    static const uint32_t reu_bytes = 0;
+    // Statistics (see instrument.h)
+    AOC64_STATS("HashSet", MAX_SIZE, "probe")
 
     // Finds an item and returns its index
     IType find(const T& item) const;
@@ -33,7 +39,7 @@ struct HashSet {
     // Checks if position i in the backing array is occupied
     int8_t isOccupied(const IType i) const { return marker[i] == FULL; }
     // Clears the set
-    void clear() { memset(marker, EMPTY, MAX_SIZE); this->iter_index = INVALID_INDEX; }
+    void clear() { memset(marker, EMPTY, MAX_SIZE); this->iter_index = INVALID_INDEX; AOC64_STAT(op(STAT_CLEAR)); AOC64_STAT(size(0)); }
     // Returns the first element
     const T* first();
     // Returns the next element
@@ -43,6 +49,7 @@ struct HashSet {
 
 template <typename T, typename IType, uint16_t MAX_SIZE>
 IType HashSet<T, IType, MAX_SIZE>::find(const T& item) const {
+    AOC64_STAT_RUN(STAT_FIND);
     const IType i0 = item.hash() % MAX_SIZE;
     IType i = i0;
     do {
@@ -50,6 +57,7 @@ IType HashSet<T, IType, MAX_SIZE>::find(const T& item) const {
             return i;
         if (marker[i] == EMPTY)
             return INVALID_INDEX;
+        AOC64_STAT(step());
         if (++i == MAX_SIZE)
             i = 0;
     } while (i != i0);
@@ -58,6 +66,7 @@ IType HashSet<T, IType, MAX_SIZE>::find(const T& item) const {
 
 template <typename T, typename IType, uint16_t MAX_SIZE>
 void HashSet<T, IType, MAX_SIZE>::insert(const T& item) {
+    AOC64_STAT_RUN(STAT_INSERT);
     const IType i0 = item.hash() % MAX_SIZE;
     IType i = i0;
     IType tombstone = INVALID_INDEX;
@@ -66,6 +75,7 @@ void HashSet<T, IType, MAX_SIZE>::insert(const T& item) {
             return;
         if (marker[i] == TOMBSTONE && tombstone == INVALID_INDEX)
             tombstone = i;
+        AOC64_STAT(step());
         if (++i == MAX_SIZE)
             i = 0;
         if (i == i0) {
@@ -78,14 +88,17 @@ void HashSet<T, IType, MAX_SIZE>::insert(const T& item) {
 
     data[i] = item;
     marker[i] = FULL;
+    AOC64_STAT(grow());
 }
 
 template <typename T, typename IType, uint16_t MAX_SIZE>
 int8_t HashSet<T, IType, MAX_SIZE>::remove(const T& item) {
+    AOC64_STAT(op(STAT_REMOVE));
     const IType i = this->find(item);
     if (i == INVALID_INDEX)
         return -1;
     marker[i] = TOMBSTONE;
+    AOC64_STAT(shrink());
     return 0;
 }
 
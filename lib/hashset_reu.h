@@ -5,6 +5,7 @@
 #include <string.h>
 #include <stdint.h>
 #include "reucpy.h"
+#include "instrument.h"
 
 // The hash set record structure (auxiliary)
 // TKey: must implement IType hash() and the == operator
@@ -35,6 +36,11 @@ struct HashSetREU {
     static const IType INVALID_INDEX = (IType)-1;
     // For iteration
     IType iter_index;
+    // Memory footprint (see budget.h)
+    static const uint32_t ram_bytes = sizeof(base_addr) + sizeof(end_addr) + sizeof(record) + sizeof(iter_index);
+    static const uint32_t reu_bytes = memory_size;
+    // Statistics (see instrument.h)
+    AOC64_STATS("HashSetREU", MAX_SIZE, "probe")
 
     // Initializes the set on the REU, needs to be called before first use
     void init(reu_addr_t addr);
@@ -73,12 +79,17 @@ void HashSetREU<TKey, IType, MAX_SIZE>::init(reu_addr_t addr) {
 
 template <typename TKey, typename IType, uint32_t MAX_SIZE>
 void HashSetREU<TKey, IType, MAX_SIZE>::clear() const {
-    for (reu_addr_t addr = this->base_addr; addr < this->end_addr; addr += (reu_addr_t)0x10000)
+    for (reu_addr_t addr = this->base_addr; addr < this->end_addr; addr += (reu_addr_t)0x10000) {
         reuset((reu_addr_t)addr, 0, 0);
+        AOC64_STAT(reu(0x10000));
+    }
+    AOC64_STAT(op(STAT_CLEAR));
+    AOC64_STAT(size(0));
 };
 
 template <typename TKey, typename IType, uint32_t MAX_SIZE>
 IType HashSetREU<TKey, IType, MAX_SIZE>::find(const TKey& key) {
+    AOC64_STAT_RUN(STAT_FIND);
     const IType i0 = key.hash() % MAX_SIZE;
     IType i = i0;
     do {
@@ -87,6 +98,7 @@ IType HashSetREU<TKey, IType, MAX_SIZE>::find(const TKey& key) {
             return i;
         if (this->record.marker == EMPTY)
             return INVALID_INDEX;
+        AOC64_STAT(step());
         if (++i == MAX_SIZE)
             i = 0;
     } while (i != i0);
@@ -95,6 +107,7 @@ IType HashSetREU<TKey, IType, MAX_SIZE>::find(const TKey& key) {
 
 template <typename TKey, typename IType, uint32_t MAX_SIZE>
 void HashSetREU<TKey, IType, MAX_SIZE>::insert(const TKey& key) {
+    AOC64_STAT_RUN(STAT_INSERT);
     const IType i0 = key.hash() % MAX_SIZE;
     IType i = i0;
     IType tombstone = INVALID_INDEX;
@@ -104,6 +117,7 @@ void HashSetREU<TKey, IType, MAX_SIZE>::insert(const TKey& key) {
             return;
         if (this->record.marker == TOMBSTONE && tombstone == INVALID_INDEX)
             tombstone = i;
+        AOC64_STAT(step());
         if (++i == MAX_SIZE)
             i = 0;
         if (i == i0) {
@@ -118,15 +132,18 @@ void HashSetREU<TKey, IType, MAX_SIZE>::insert(const TKey& key) {
     this->record.marker = FULL;
     this->record.key = key;
     this->_set_record(i);
+    AOC64_STAT(grow());
 }
 
 template <typename TKey, typename IType, uint32_t MAX_SIZE>
 int8_t HashSetREU<TKey, IType, MAX_SIZE>::remove(const TKey& key) {
+    AOC64_STAT(op(STAT_REMOVE));
     const IType i = this->find(key);
     if (i == INVALID_INDEX)
         return -1;
     this->record.marker = TOMBSTONE;
     this->_set_record_marker(i);
+    AOC64_STAT(shrink());
     return 0;
 }
 
@@ -143,21 +160,25 @@ IType HashSetREU<TKey, IType, MAX_SIZE>::size() {
 template <typename TKey, typename IType, uint32_t MAX_SIZE>
 void HashSetREU<TKey, IType, MAX_SIZE>::_get_record(const IType i) {
     reucpy((void *)&(this->record), this->_get_addr(i), this->record_size, REU2RAM);
+    AOC64_STAT(reu(this->record_size));
 }
 
 template <typename TKey, typename IType, uint32_t MAX_SIZE>
 void HashSetREU<TKey, IType, MAX_SIZE>::_set_record(const IType i) const {
     reucpy((void *)&(this->record), this->_get_addr(i), this->record_size, RAM2REU);
+    AOC64_STAT(reu(this->record_size));
 }
 
 template <typename TKey, typename IType, uint32_t MAX_SIZE>
 void HashSetREU<TKey, IType, MAX_SIZE>::_get_record_marker(const IType i) {
     reucpy((void *)&this->record.marker, this->_get_addr(i), 1, REU2RAM);
+    AOC64_STAT(reu(1));
 }
 
 template <typename TKey, typename IType, uint32_t MAX_SIZE>
 void HashSetREU<TKey, IType, MAX_SIZE>::_set_record_marker(const IType i) const {
     reucpy((void *)&this->record.marker, this->_get_addr(i), 1, RAM2REU);
+    AOC64_STAT(reu(1));
 }
 
 template <typename TKey, typename IType, uint32_t MAX_SIZE>
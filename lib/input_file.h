@@ -0,0 +1,195 @@
+#ifndef __INPUT_FILE_H__
+#define __INPUT_FILE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "AoC64.h"
+
+// Runtime input for host builds: with AOC64_INPUT=<file> a day reads the raw puzzle input from
+// <file> instead of its compiled-in input.h, so a new or larger input needs no recompile.
+// The file is memory mapped (privately) and parsed in place, the time spent is the "load" phase:
+// - input_lines(): each line is terminated where it ends and the array points into the mapping,
+// - input_numbers(): every integer of the file (with its sign), grouped into records of type T,
+//   a number type or an array of numbers (e.g. int16_t[4] for the "x1,y1 -> x2,y2" lines of day 5).
+// - input_stream() and input_next_line(): the lines one at a time, read in place and not kept, for
+//   days that stream their input in O(line) memory (the mapping stays clean, the kernel may drop
+//   the pages already read).
+// They leave data and n untouched and return false when AOC64_INPUT is not set, and always on the
+// C64, where the compile-time input stays.
+//
+//     const uint16_t* depths = lines;
+//     uint16_t n = sizeof(lines) / sizeof(lines[0]);
+//     input_numbers(depths, n);
+#ifdef __mos6502__
+template <typename T, typename N>
+static inline bool input_lines(T*&, N&) { return false; }
+template <typename T, typename N>
+static inline bool input_numbers(T*&, N&) { return false; }
+static inline bool input_stream() { return false; }
+static inline bool input_next_line(const char*&, size_t&) { return false; }
+#else
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+// the mapping of AOC64_INPUT (or of the current input of a batch, see batch.h), size 0 if none;
+// the days keep pointers into it, so it stays mapped until the next input is opened
+static struct {
+    const char* path;
+    char* data;
+    size_t size;
+    bool loaded;
+    void* parsed;      // lines or numbers of the input, freed with the mapping
+    char* last_line;   // copy of an unterminated last line, freed with the mapping
+    const char* next;  // where input_next_line() continues
+} _input_file;
+
+// Maps the input file at path in place of the previous one, false (with a message) if it can't be read
+static bool input_file_open(const char* const path) {
+    if (_input_file.size > 0)
+        munmap(_input_file.data, _input_file.size);
+    free(_input_file.parsed);
+    free(_input_file.last_line);
+    _input_file = {path, nullptr, 0, true, nullptr, nullptr, nullptr};
+    const int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        perror(path);
+        if (fd >= 0)
+            close(fd);
+        return false;
+    }
+    if (st.st_size == 0) {
+        fprintf(stderr, "%s: empty input\n", path);
+        close(fd);
+        return false;
+    }
+    // private and writable: input_lines() terminates the lines in place
+    void* const m = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (m == MAP_FAILED) {
+        perror(path);
+        return false;
+    }
+    _input_file.data = (char*)m;
+    _input_file.size = st.st_size;
+    return true;
+}
+
+static bool _input_map() {
+    if (_input_file.loaded)
+        return _input_file.size > 0;
+    _input_file.loaded = true;
+    const char* const path = getenv("AOC64_INPUT");
+    if (path == nullptr || *path == 0)
+        return false;
+    if (!input_file_open(path))
+        exit(1);
+    return true;
+}
+
+// Points data at the lines of the input file, a trailing empty line is dropped
+template <typename T, typename N>
+bool input_lines(T*& data, N& n) {
+    static_assert(std::is_pointer_v<std::remove_cv_t<T>>, "input_lines() needs an array of strings");
+    if (!_input_map())
+        return false;
+    AOC64_PHASE("load");
+    char* p = _input_file.data;
+    char* const end = p + _input_file.size;
+    size_t count = 0;
+    for (const char* q = p; q < end; ++q)
+        count += *q == '\n';
+    count += end[-1] != '\n';
+    char** const lines = (char**)malloc(count * sizeof(char*));
+    assert(lines != nullptr);
+    count = 0;
+    while (p < end) {
+        lines[count++] = p;
+        while (p < end && *p != '\n')
+            ++p;
+        if (p > lines[count - 1] && p[-1] == '\r')
+            p[-1] = 0;
+        if (p < end) {
+            *p++ = 0;
+        } else if (_input_file.size % getpagesize() == 0) {
+            // no newline at the end and no zero-filled page tail to terminate the last line
+            lines[count - 1] = _input_file.last_line = strndup(lines[count - 1], p - lines[count - 1]);
+        }
+    }
+    assert((size_t)(N)count == count && "too many lines for the count type of the day");
+    _input_file.parsed = lines;
+    data = (T*)lines;
+    n = (N)count;
+    return true;
+}
+
+// Starts reading the lines of the input file from its first one
+static bool input_stream() {
+    if (!_input_map())
+        return false;
+    madvise(_input_file.data, _input_file.size, MADV_SEQUENTIAL);
+    _input_file.next = _input_file.data;
+    return true;
+}
+
+// The next line of the input file (without its end, not terminated), false after the last one
+static bool input_next_line(const char*& line, size_t& len) {
+    const char* const end = _input_file.data + _input_file.size;
+    const char* p = _input_file.next;
+    if (p == nullptr || p >= end)
+        return false;
+    line = p;
+    const char* const eol = (const char*)memchr(p, '\n', end - p);
+    _input_file.next = eol ? eol + 1 : end;
+    len = (eol ? eol : end) - p;
+    if (len > 0 && p[len - 1] == '\r')
+        --len;
+    return true;
+}
+
+// Parses every integer of the input file into records of type T
+template <typename T, typename N>
+bool input_numbers(T*& data, N& n) {
+    typedef std::remove_cv_t<std::remove_all_extents_t<T>> Number;
+    constexpr size_t PER_RECORD = sizeof(T) / sizeof(Number);
+    if (!_input_map())
+        return false;
+    AOC64_PHASE("load");
+    const char* p = _input_file.data;
+    const char* const end = p + _input_file.size;
+    // no more numbers than every other byte
+    Number* const numbers = (Number*)malloc((_input_file.size / 2 + PER_RECORD) * sizeof(Number));
+    assert(numbers != nullptr);
+    size_t count = 0;
+    while (p < end) {
+        if (*p < '0' || *p > '9') {
+            ++p;
+            continue;
+        }
+        const bool negative = p > _input_file.data && p[-1] == '-';
+        int64_t v = 0;
+        while (p < end && *p >= '0' && *p <= '9')
+            v = 10 * v + (*p++ - '0');
+        numbers[count++] = (Number)(negative ? -v : v);
+    }
+    if (count % PER_RECORD) {
+        fprintf(stderr, "%s: %zu numbers, not a multiple of %zu\n", _input_file.path, count, PER_RECORD);
+        exit(1);
+    }
+    count /= PER_RECORD;
+    assert((size_t)(N)count == count && "too many records for the count type of the day");
+    _input_file.parsed = numbers;
+    data = (T*)numbers;
+    n = (N)count;
+    return true;
+}
+#endif
+
+#endif // __INPUT_FILE_H__
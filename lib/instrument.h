@@ -0,0 +1,156 @@
+#ifndef __INSTRUMENT_H__
+#define __INSTRUMENT_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "report.h"
+
+// Opt-in container instrumentation, compile with -DAOC64_INSTRUMENT (cmake -DAOC64_INSTRUMENT=ON).
+// The containers count their operations, the length of each probe sequence (hash sets/maps) or
+// sift (heaps), their peak occupancy and the bytes they move to and from the REU. finish() dumps
+// the statistics of every container used, as a table on the C64 and as JSON on the host.
+// Without AOC64_INSTRUMENT the macros below expand to nothing.
+//
+// In a container:
+//     AOC64_STATS("Stack", MAX_SIZE, nullptr)     // declares the statistics (kind, capacity, histogram)
+//     AOC64_STAT(op(STAT_INSERT));                // counts an operation
+//     AOC64_STAT(size(sp));                       // current occupancy (also tracks the peak)
+//     AOC64_STAT(step());                         // one more probe/sift step of the current operation
+//     AOC64_STAT(end_run());                      // adds the steps of the current operation to the histogram
+//     AOC64_STAT_RUN(STAT_FIND);                  // counts an operation and calls end_run() when the scope exits
+//     AOC64_STAT(reu(sizeof(T)));                 // bytes transferred to or from the REU
+#ifdef AOC64_INSTRUMENT
+
+enum { STAT_INSERT, STAT_REMOVE, STAT_FIND, STAT_CLEAR, N_STAT_OPS };
+constexpr uint8_t STAT_BINS = 16; // histogram of 0..14 and 15+ steps
+constexpr uint8_t MAX_STATS = 16; // containers in the registry, the others share slots (see stats_attach)
+
+struct ContainerStats {
+    const char* kind;
+    const char* hist;  // what the histogram counts ("probe", "sift"), nullptr if none
+    uint32_t capacity;
+    uint32_t ops[N_STAT_OPS];
+    uint32_t current, peak;
+    uint32_t bins[STAT_BINS];
+    uint32_t reu_bytes;
+    uint16_t run;      // steps of the current operation
+    uint8_t containers; // sharing these statistics
+
+    ContainerStats& op(const uint8_t o) { ++ops[o]; return *this; }
+    void size(const uint32_t n) { current = n; if (n > peak) peak = n; }
+    void grow() { size(current + 1); }
+    void shrink() { if (current) --current; }
+    void step() { ++run; }
+    void end_run() { ++bins[run < STAT_BINS ? run : STAT_BINS - 1]; run = 0; }
+    void reu(const uint32_t bytes) { reu_bytes += bytes; }
+};
+
+// ends the run of steps of an operation when it returns
+struct StatRun {
+    ContainerStats& s;
+    ~StatRun() { s.end_run(); }
+};
+
+static struct {
+    ContainerStats stats[MAX_STATS + 1];  // the last one for the containers of no kind registered
+    uint8_t count;
+    uint16_t shared;  // containers without statistics of their own
+} _stats_registry;
+
+static const char* const _stat_op_names[N_STAT_OPS] = {"insert", "remove", "find", "clear"};
+
+#ifdef __mos6502__
+// one block of up to 4 lines per container, fits the 40 column screen
+static void _print_stats(const void*) {
+    for (uint8_t c = 0; c <= MAX_STATS; ++c) {
+        const ContainerStats& s = _stats_registry.stats[c];
+        if (s.containers == 0)
+            continue;
+        printf("\n%s", s.kind);
+        if (s.containers > 1)
+            printf(" x%u", s.containers);
+        if (s.capacity)
+            printf(" cap %lu peak %lu (%u%%)", s.capacity, s.peak, (uint8_t)(100 * s.peak / s.capacity));
+        printf("\n ins %lu rm %lu find %lu clr %lu", s.ops[STAT_INSERT], s.ops[STAT_REMOVE], s.ops[STAT_FIND], s.ops[STAT_CLEAR]);
+        if (s.hist) {
+            printf("\n %s", s.hist);
+            for (uint8_t b = 0; b < STAT_BINS; ++b)
+                if (s.bins[b])
+                    printf(" %u%s:%lu", b, b == STAT_BINS - 1 ? "+" : "", s.bins[b]);
+        }
+        if (s.reu_bytes)
+            printf("\n reu %lu bytes", s.reu_bytes);
+    }
+    if (_stats_registry.shared)
+        printf("\n%u containers shared stats", _stats_registry.shared);
+}
+#else
+static void _print_stats(const void*) {
+    printf("\n{\"containers\": [");
+    for (uint8_t c = 0; c <= MAX_STATS; ++c) {
+        const ContainerStats& s = _stats_registry.stats[c];
+        if (s.containers == 0)
+            continue;
+        printf("%s\n  {\"kind\": \"%s\", \"containers\": %u, \"capacity\": %u, \"peak\": %u", c ? "," : "",
+               s.kind, s.containers, s.capacity, s.peak);
+        for (uint8_t o = 0; o < N_STAT_OPS; ++o)
+            printf(", \"%s\": %u", _stat_op_names[o], s.ops[o]);
+        if (s.hist) {
+            printf(", \"%s\": [", s.hist);
+            for (uint8_t b = 0; b < STAT_BINS; ++b)
+                printf("%s%u", b ? ", " : "", s.bins[b]);
+            printf("]");
+        }
+        printf(", \"reu_bytes\": %u}", s.reu_bytes);
+    }
+    printf("\n], \"shared\": %u}", _stats_registry.shared);
+}
+#endif
+
+// Registers a container and returns its id (index + 1). Beyond MAX_STATS a container shares the
+// statistics of one of the same kind and capacity (e.g. the stack of each scanner of day 19), or
+// else the last slot ("others"); the peak of shared statistics is only indicative.
+static inline uint8_t stats_attach(const char* const kind, const uint32_t capacity, const char* const hist) {
+    if (_stats_registry.count == 0)
+        at_finish(_print_stats, nullptr);
+    uint8_t id = _stats_registry.count;
+    if (id == MAX_STATS) {
+        ++_stats_registry.shared;
+        id = 0;
+        while (id < MAX_STATS && (strcmp(_stats_registry.stats[id].kind, kind) != 0 || _stats_registry.stats[id].capacity != capacity))
+            ++id;
+        ContainerStats& s = _stats_registry.stats[id];
+        if (id == MAX_STATS && s.containers == 0) {
+            s.kind = "others";
+            s.hist = hist;
+        }
+        ++s.containers;
+        return id + 1;
+    }
+    ContainerStats& s = _stats_registry.stats[_stats_registry.count++];
+    s.kind = kind;
+    s.capacity = capacity;
+    s.hist = hist;
+    s.containers = 1;
+    return _stats_registry.count;
+}
+
+// The statistics live in the registry (so they outlive the container), the container keeps its id
+#define AOC64_STATS(KIND, CAPACITY, HIST) \
+    mutable uint8_t _stats_id = 0; \
+    ContainerStats& _st() const { \
+        if (!_stats_id) \
+            _stats_id = stats_attach(KIND, CAPACITY, HIST); \
+        return _stats_registry.stats[_stats_id - 1]; \
+    }
+#define AOC64_STAT(CALL) (this->_st().CALL)
+#define AOC64_STAT_RUN(OP) StatRun _stat_run{this->_st().op(OP)}
+
+#else
+#define AOC64_STATS(KIND, CAPACITY, HIST)
+#define AOC64_STAT(CALL) ((void)0)
+#define AOC64_STAT_RUN(OP) ((void)0)
+#endif
+
+#endif // __INSTRUMENT_H__
@@ -0,0 +1,179 @@
+#ifndef __LINREC_H__
+#define __LINREC_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Constant-size linear recurrences: a state of N counts advanced by a fixed N x N matrix, v' = M v,
+// e.g. the companion matrix of x[n] = c[0] x[n-1] + ... + c[N-1] x[n-N]. advance() jumps any number
+// of steps with log2(steps) squarings of M (N^3 products each) instead of one step at a time. The
+// counts are any type with +=, * and a test for zero (bool): unsigned integers (modulo 2^bits), ModInt
+// (modulo p) or BigUInt (exact up to a fixed number of bits).
+
+template <typename T, uint8_t N>
+struct Matrix {
+    T a[N][N];
+};
+
+// r = x y, r must be neither x nor y
+template <typename T, uint8_t N>
+void matrix_mul(const Matrix<T, N>& x, const Matrix<T, N>& y, Matrix<T, N>& r) {
+    for (uint8_t i = 0; i < N; ++i) {
+        for (uint8_t j = 0; j < N; ++j)
+            r.a[i][j] = T(0);
+        for (uint8_t k = 0; k < N; ++k) {
+            if (!x.a[i][k])
+                continue;
+            for (uint8_t j = 0; j < N; ++j)
+                if (y.a[k][j])
+                    r.a[i][j] += x.a[i][k] * y.a[k][j];
+        }
+    }
+}
+
+// v = M^steps v, M is squared in place (left as M^(2^bits of steps))
+template <typename T, uint8_t N>
+void advance(Matrix<T, N>& m, uint64_t steps, T (&v)[N]) {
+    static Matrix<T, N> square;
+    static T w[N];
+    for (; steps; steps >>= 1) {
+        if (steps & 1) {
+            for (uint8_t i = 0; i < N; ++i) {
+                w[i] = T(0);
+                for (uint8_t j = 0; j < N; ++j)
+                    if (m.a[i][j] && v[j])
+                        w[i] += m.a[i][j] * v[j];
+            }
+            for (uint8_t i = 0; i < N; ++i)
+                v[i] = w[i];
+        }
+        if (steps > 1) {
+            matrix_mul(m, m, square);
+            m = square;
+        }
+    }
+}
+
+// The companion matrix of x[n] = c[0] x[n-1] + ... + c[N-1] x[n-N], for the state (x[n-1], ..., x[n-N])
+template <typename T, uint8_t N>
+void companion(const T (&c)[N], Matrix<T, N>& m) {
+    for (uint8_t i = 0; i < N; ++i)
+        for (uint8_t j = 0; j < N; ++j)
+            m.a[i][j] = i == 0 ? c[j] : T(j + 1 == i ? 1 : 0);
+}
+
+// x[n] of x[n] = c[0] x[n-1] + ... + c[N-1] x[n-N] from x[0 .. N-1]
+template <typename T, uint8_t N>
+T nth(const T (&c)[N], const T (&first)[N], const uint64_t n) {
+    if (n < N)
+        return first[n];
+    static Matrix<T, N> m;
+    companion(c, m);
+    T v[N];
+    for (uint8_t i = 0; i < N; ++i)
+        v[i] = first[N - 1 - i];
+    advance(m, n - (N - 1), v);
+    return v[0];
+}
+
+// Counts modulo p (< 2^32, set once in ModInt::p)
+struct ModInt {
+    static inline uint32_t p = 1000000007;
+    uint32_t v;
+
+    ModInt(const uint64_t x = 0) : v(x % p) {}
+    ModInt& operator+=(const ModInt& o) {
+        v = ((uint64_t)v + o.v) % p;
+        return *this;
+    }
+    ModInt operator*(const ModInt& o) const { return ModInt((uint64_t)v * o.v); }
+    explicit operator bool() const { return v != 0; }
+};
+
+// Exact counts of up to 32 * LIMBS bits, overflow is remembered by the results instead
+template <uint16_t LIMBS>
+struct BigUInt {
+    uint32_t limb[LIMBS]; // least significant first, the first n in use
+    uint16_t n;
+    bool overflow;
+
+    BigUInt(uint64_t x = 0) : n(0), overflow(false) {
+        for (; x; x >>= 32)
+            limb[n++] = (uint32_t)x;
+    }
+    BigUInt(const BigUInt& o) { *this = o; }
+    BigUInt& operator=(const BigUInt& o) {
+        n = o.n;
+        overflow = o.overflow;
+        memcpy(limb, o.limb, n * sizeof(uint32_t));
+        return *this;
+    }
+    BigUInt& operator+=(const BigUInt& o) {
+        overflow |= o.overflow;
+        uint64_t carry = 0;
+        uint16_t i = 0;
+        for (; i < o.n || (carry && i < LIMBS); ++i) {
+            carry += (i < n ? limb[i] : 0) + (uint64_t)(i < o.n ? o.limb[i] : 0);
+            limb[i] = (uint32_t)carry;
+            carry >>= 32;
+        }
+        if (i > n)
+            n = i;
+        overflow |= carry != 0;
+        return *this;
+    }
+    BigUInt operator*(const BigUInt& o) const {
+        BigUInt r;
+        r.overflow = overflow || o.overflow;
+        if (n == 0 || o.n == 0)
+            return r;
+        r.n = n + o.n > LIMBS ? LIMBS : n + o.n;
+        memset(r.limb, 0, r.n * sizeof(uint32_t));
+        for (uint16_t i = 0; i < n; ++i) {
+            uint64_t carry = 0;
+            uint16_t j = 0;
+            for (; j < o.n && i + j < LIMBS; ++j) {
+                carry += (uint64_t)limb[i] * o.limb[j] + r.limb[i + j];
+                r.limb[i + j] = (uint32_t)carry;
+                carry >>= 32;
+            }
+            // what is left beyond the capacity
+            r.overflow |= j < o.n;
+            if (carry) {
+                if (i + j < LIMBS)
+                    r.limb[i + j] = (uint32_t)carry;
+                else
+                    r.overflow = true;
+            }
+        }
+        while (r.n > 0 && r.limb[r.n - 1] == 0)
+            --r.n;
+        return r;
+    }
+    explicit operator bool() const { return n != 0; }
+
+    // prints the decimal digits, 9 at a time (base 10^9) from a copy divided in place
+    void print() const {
+        static uint32_t q[LIMBS];
+        static uint32_t digits[LIMBS * 32 / 29 + 1];
+        memcpy(q, limb, n * sizeof(uint32_t));
+        uint16_t m = n, d = 0;
+        while (m > 0) {
+            uint64_t rem = 0;
+            for (uint16_t i = m; i-- > 0;) {
+                rem = rem << 32 | q[i];
+                q[i] = (uint32_t)(rem / 1000000000);
+                rem %= 1000000000;
+            }
+            digits[d++] = (uint32_t)rem;
+            while (m > 0 && q[m - 1] == 0)
+                --m;
+        }
+        printf("%lu", d ? (unsigned long)digits[d - 1] : 0ul);
+        for (uint16_t i = d - 1; d && i-- > 0;)
+            printf("%09lu", (unsigned long)digits[i]);
+    }
+};
+
+#endif // __LINREC_H__
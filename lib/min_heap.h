@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <assert.h>
+#include "instrument.h"
 
 // The heap structure.
 // The struct T must provide a priority member variable in the first slot:
@@ -15,6 +16,11 @@ struct Heap {
 	// Data
 	T arr[MAX_SIZE];
 	IType _size;
+	// Memory footprint (see budget.h)
+	static const uint32_t ram_bytes = sizeof(arr) + sizeof(_size);
+	static const uint32_t reu_bytes = 0;
+	// Statistics (see instrument.h)
+	AOC64_STATS("Heap", MAX_SIZE, "sift")
 	// Initializes the min heap
 	void init();
 	void init(const T* const items, const IType n_items);
@@ -26,7 +32,7 @@ struct Heap {
 	// Returns the number of elements
 	const IType size() const { return _size; }
 	// Clears the heap
-	void clear() { _size = 0; }
+	void clear() { _size = 0; AOC64_STAT(op(STAT_CLEAR)); AOC64_STAT(size(0)); }
 
 	// internal helper functions
 	void _insert_helper(IType idx);
@@ -37,9 +43,10 @@ struct Heap {
 template <typename T, typename IType, uint16_t MAX_SIZE>
 void Heap<T, IType, MAX_SIZE>::init() {
 	_size = 0;
+	AOC64_STAT(op(STAT_CLEAR));
+	AOC64_STAT(size(0));
 }
 
-// Warning: this implementation works only for size > 1
 template <typename T, typename IType, uint16_t MAX_SIZE>
 void Heap<T, IType, MAX_SIZE>::init(const T* const items, const IType size) {
 	_size = 0;
@@ -48,11 +55,11 @@ void Heap<T, IType, MAX_SIZE>::init(const T* const items, const IType size) {
 	for (i = 0; i < size; i++)
 		arr[i] = items[i];
 	_size = i;
-	i = (_size - 2) >> 1;
-	while (i >= 0) {
+	// heapify the parents bottom-up (also works for unsigned index types)
+	for (i = _size >> 1; i-- > 0;)
 		_heapify(i);
-		i--;
-	}
+	AOC64_STAT(op(STAT_CLEAR));
+	AOC64_STAT(size(_size));
 }
 
 template <typename T, typename IType, uint16_t MAX_SIZE>
@@ -63,7 +70,9 @@ void Heap<T, IType, MAX_SIZE>::_insert_helper(IType idx) {
         arr[parent_node] = arr[idx];
         arr[idx] = temp;
         idx = parent_node;
+        AOC64_STAT(step());
     }
+    AOC64_STAT(end_run());
 }
 
 template <typename T, typename IType, uint16_t MAX_SIZE>
@@ -73,12 +82,12 @@ void Heap<T, IType, MAX_SIZE>::_heapify(IType idx) {
 		IType right = left + 1;
 		IType min = idx;
 		if (left  >= _size || left < 0)
-			left = -1;
+			left = (IType)-1;
 		if (right >= _size || right < 0)
-			right = -1;
-		if (left  != -1 && arr[left].priority  < arr[idx].priority)
+			right = (IType)-1;
+		if (left  != (IType)-1 && arr[left].priority  < arr[idx].priority)
 			min = left;
-		if (right != -1 && arr[right].priority < arr[min].priority)
+		if (right != (IType)-1 && arr[right].priority < arr[min].priority)
 			min = right;
 		if (min == idx)
 			break;
@@ -86,7 +95,9 @@ void Heap<T, IType, MAX_SIZE>::_heapify(IType idx) {
 		arr[min] = arr[idx];
 		arr[idx] = temp;
 		idx = min;
+		AOC64_STAT(step());
 	}
+	AOC64_STAT(end_run());
 }
 
 template <typename T, typename IType, uint16_t MaxSize>
@@ -97,6 +108,8 @@ T Heap<T, IType, MaxSize>::pop() {
 	arr[0] = arr[_size - 1];
 	_size--;
 	_heapify(0);
+	AOC64_STAT(op(STAT_REMOVE));
+	AOC64_STAT(size(_size));
 	return deleteItem;
 }
 
@@ -106,6 +119,8 @@ void Heap<T, IType, MAX_SIZE>::push(const T& n) {
 	arr[_size] = n;
 	_insert_helper(_size);
 	_size++;
+	AOC64_STAT(op(STAT_INSERT));
+	AOC64_STAT(size(_size));
 }
 
 template <typename T, typename IType, uint16_t MAX_SIZE>
@@ -114,6 +129,8 @@ void Heap<T, IType, MAX_SIZE>::push(const T&& n) {
 	arr[_size] = n;
 	_insert_helper(_size);
 	_size++;
+	AOC64_STAT(op(STAT_INSERT));
+	AOC64_STAT(size(_size));
 }
 
 #endif //__MIN_HEAP_H__
@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <assert.h>
 #include "reucpy.h"
+#include "instrument.h"
 
 // The heap structure implemented on the REU.
 // The struct T must provide a priority member variable in the first slot:
@@ -21,6 +22,11 @@ struct HeapREU {
 	// For memory sizes
 	static const uint16_t record_size = (uint16_t)sizeof(T);
     static const reu_addr_t memory_size = (reu_addr_t)(MAX_SIZE*record_size);
+    // Memory footprint (see budget.h)
+    static const uint32_t ram_bytes = sizeof(base_addr) + sizeof(end_addr) + sizeof(record) + sizeof(_size);
+    static const uint32_t reu_bytes = memory_size;
+    // Statistics (see instrument.h)
+    AOC64_STATS("HeapREU", MAX_SIZE, "sift")
 	// Initializes the min heap at the REU address addr
 	void init(const reu_addr_t addr);
 	// Initializes the min heap with initial elements given by items at the REU address addr
@@ -49,34 +55,41 @@ struct HeapREU {
 template <typename T, typename IType, uint32_t MAX_SIZE>
 void HeapREU<T, IType, MAX_SIZE>::_get_record(const IType i) {
     reucpy((void *)&(this->record), this->_get_addr(i), this->record_size, REU2RAM);
+    AOC64_STAT(reu(this->record_size));
 }
 
 template <typename T, typename IType, uint32_t MAX_SIZE>
 void HeapREU<T, IType, MAX_SIZE>::_get_record(const IType i, T* dest) {
     reucpy((void *)dest, this->_get_addr(i), this->record_size, REU2RAM);
+    AOC64_STAT(reu(this->record_size));
 }
 
 template <typename T, typename IType, uint32_t MAX_SIZE>
 uint16_t HeapREU<T, IType, MAX_SIZE>::_get_priority(const IType i) {
 	uint16_t priority;
 	reucpy((void *)&priority, this->_get_addr(i), 2, REU2RAM);
+	AOC64_STAT(reu(2));
 	return priority;
 }
 
 template <typename T, typename IType, uint32_t MAX_SIZE>
 void HeapREU<T, IType, MAX_SIZE>::_set_record(const IType i) const {
     reucpy((void *)&(this->record), this->_get_addr(i), this->record_size, RAM2REU);
+    AOC64_STAT(reu(this->record_size));
 }
 
 template <typename T, typename IType, uint32_t MAX_SIZE>
 void HeapREU<T, IType, MAX_SIZE>::_set_record(const IType i, const T* const src) const {
     reucpy((void *)src, this->_get_addr(i), this->record_size, RAM2REU);
+    AOC64_STAT(reu(this->record_size));
 }
 
 template <typename T, typename IType, uint32_t MAX_SIZE>
 void HeapREU<T, IType, MAX_SIZE>::init(const reu_addr_t addr) {
 	this->_size = 0;
     this->base_addr = addr;
+	AOC64_STAT(op(STAT_CLEAR));
+	AOC64_STAT(size(0));
     this->end_addr = addr + this->memory_size;
 }
 
@@ -85,13 +98,12 @@ void HeapREU<T, IType, MAX_SIZE>::init(const T* const items, const IType size, c
 	this->init(addr);
 	IType i;
 	for (i = 0; i < size; i++)
-		reucpy((void *)&(items[i]), this->_get_addr(i), 1, RAM2REU);
+		this->_set_record(i, &items[i]);
 	this->_size = i;
-	i = (this->_size - 2) >> 1;
-	while (i >= 0) {
+	// heapify the parents bottom-up (also works for unsigned index types)
+	for (i = this->_size >> 1; i-- > 0;)
 		this->_heapify(i);
-		i--;
-	}
+	AOC64_STAT(size(this->_size));
 }
 
 template <typename T, typename IType, uint32_t MaxSize>
@@ -103,7 +115,9 @@ void HeapREU<T, IType, MaxSize>::_insert_helper(IType idx) {
         this->_get_record(idx); this->_set_record(parent_node);
 		this->_set_record(idx, &temp);
         idx = parent_node;
+        AOC64_STAT(step());
     }
+    AOC64_STAT(end_run());
 }
 
 template <typename T, typename IType, uint32_t MaxSize>
@@ -112,17 +126,19 @@ void HeapREU<T, IType, MaxSize>::_heapify(IType idx) {
 		IType left  = (idx << 1) + 1;
 		IType right = (idx << 1) + 2;
 		IType min = idx;
-		if (left  >= this->_size || left < 0)  left = -1;
-		if (right >= this->_size || right < 0) right = -1;
-		if (left  != -1 && this->_get_priority(left) < this->_get_priority(idx)) min = left;
-		if (right != -1 && this->_get_priority(right) < this->_get_priority(min)) min = right;
+		if (left  >= this->_size || left < 0)  left = (IType)-1;
+		if (right >= this->_size || right < 0) right = (IType)-1;
+		if (left  != (IType)-1 && this->_get_priority(left) < this->_get_priority(idx)) min = left;
+		if (right != (IType)-1 && this->_get_priority(right) < this->_get_priority(min)) min = right;
 		if (min == idx) break;
 		T temp;
 		this->_get_record(min, &temp);
 		this->_get_record(idx); this->_set_record(min);
 		this->_set_record(idx, &temp);
 		idx = min;
+		AOC64_STAT(step());
 	}
+	AOC64_STAT(end_run());
 }
 
 template <typename T, typename IType, uint32_t MaxSize>
@@ -134,6 +150,8 @@ T HeapREU<T, IType, MaxSize>::pop() {
 	this->_set_record(0);
 	this->_size--;
 	this->_heapify(0);
+	AOC64_STAT(op(STAT_REMOVE));
+	AOC64_STAT(size(this->_size));
 	return deleteItem;
 }
 
@@ -145,6 +163,8 @@ void HeapREU<T, IType, MaxSize>::popInto(T* const item) {
 	this->_set_record(0);
 	this->_size--;
 	this->_heapify(0);
+	AOC64_STAT(op(STAT_REMOVE));
+	AOC64_STAT(size(this->_size));
 }
 
 template <typename T, typename IType, uint32_t MaxSize>
@@ -153,6 +173,8 @@ void HeapREU<T, IType, MaxSize>::push(const T* const n) {
 	this->_set_record(this->_size, n);
 	this->_insert_helper(this->_size);
 	this->_size++;
+	AOC64_STAT(op(STAT_INSERT));
+	AOC64_STAT(size(this->_size));
 }
 
 #endif //__MIN_HEAP_REU_H__
@@ -0,0 +1,63 @@
+#ifndef __OPTIONS_H__
+#define __OPTIONS_H__
+
+#include <stdint.h>
+
+// Numeric command line options of the host builds, "--name value" pairs after the program name.
+// Each value is a decimal number in lo .. hi; anything else (an unknown name, a missing, negative,
+// non-numeric or out of range value) makes parse_options() return -1, and the day prints its
+// usage and exits with 2 before init(). The options end at the first argument not starting with
+// "--", the inputs of a batch (batch.h) follow them:
+//
+//     static unsigned long long days = 0, mod = 0;
+//     const Option options[] = {{"--days", 1, UINT64_MAX, &days}, {"--mod", 2, UINT32_MAX, &mod}};
+//     const int skip = parse_options(argc, argv, options);
+//     if (skip < 0 || (mod && days == 0)) {
+//         fprintf(stderr, "usage: %s [--days n [--mod p (2 .. 2^32-1)]] [input ... | -]\n", argv[0]);
+//         return 2;
+//     }
+//     init(6);
+//     if (!batch(argc - skip, argv + skip, solve))
+//         solve();
+struct Option {
+    const char* name;
+    unsigned long long lo, hi;
+    unsigned long long* value;  // set when the option is given
+};
+
+#ifdef __mos6502__
+template <uint8_t N>
+static inline int parse_options(int, char**, const Option (&)[N]) { return 0; }
+#else
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The decimal number s in lo .. hi, false if it is not one
+static bool parse_number(const char* const s, const unsigned long long lo, const unsigned long long hi,
+                         unsigned long long& value) {
+    if (*s < '0' || *s > '9')
+        return false;
+    char* end;
+    errno = 0;
+    value = strtoull(s, &end, 10);
+    return *end == 0 && errno == 0 && value >= lo && value <= hi;
+}
+
+// Sets the values of the options at the start of argv, returns the number of arguments they take,
+// -1 on anything that is not one of them
+template <uint8_t N>
+static int parse_options(const int argc, char** const argv, const Option (&options)[N]) {
+    int i = 1;
+    for (; i < argc && strncmp(argv[i], "--", 2) == 0; i += 2) {
+        uint8_t k = 0;
+        while (k < N && strcmp(argv[i], options[k].name) != 0)
+            ++k;
+        if (k == N || i + 1 == argc || !parse_number(argv[i + 1], options[k].lo, options[k].hi, *options[k].value))
+            return -1;
+    }
+    return i - 1;
+}
+#endif
+
+#endif // __OPTIONS_H__
@@ -0,0 +1,107 @@
+#ifndef __PROGRESS_H__
+#define __PROGRESS_H__
+
+#include <stdint.h>
+#include "AoC64.h"
+#ifndef __mos6502__
+#include <unistd.h>
+#endif
+
+// Sampling progress reporter for hot loops, replaces hand-tuned tick((i >> k) & 7) calls.
+// step() only counts down, every 2^SHIFT steps the work counter is updated and the clock is read:
+// - C64: the spinner advances every FRAME_JIFFIES jiffies, however fast the loop is.
+// - host: throughput (and ETA when the total is known) is printed to stderr a few times
+//   a second, only when stderr is a terminal. done() (or the destructor) clears the line.
+//
+//     Progress<4> progress("states", expected_states);
+//     while (...) {
+//         progress.step();
+//         ...
+//     }
+template <uint8_t SHIFT = 4>
+struct Progress {
+    static_assert(SHIFT < 16, "SHIFT must be below 16");
+    static const uint16_t PERIOD = (uint16_t)1 << SHIFT;
+#ifdef __mos6502__
+    static const aoc64_time_t FRAME_JIFFIES = 4;    // ~12 frames per second on PAL
+#else
+    static const aoc64_time_t REPORT_NS = 250000000; // 4 reports per second
+#endif
+
+    const char* unit;
+    uint32_t total;     // expected amount of work, 0 if unknown
+    uint32_t count;     // work done, updated every PERIOD steps
+    uint16_t left;      // steps until the next sample
+    aoc64_time_t start; // time of the last reset
+    aoc64_time_t last;  // time of the last spinner update or report
+#ifdef __mos6502__
+    uint8_t frame;
+#else
+    bool tty;
+    bool shown;         // a report is on screen
+#endif
+
+    Progress(const char* const unit, const uint32_t total = 0) : unit(unit) {
+#ifdef __mos6502__
+        frame = 0;
+#else
+        tty = isatty(STDERR_FILENO);
+        shown = false;
+#endif
+        reset(total);
+    }
+    ~Progress() { done(); }
+
+    // starts counting from zero again (e.g. for part 2)
+    void reset(const uint32_t total = 0) {
+        this->total = total;
+        count = 0;
+        left = PERIOD;
+        start = last = aoc64_now();
+    }
+
+    // one unit of work done
+    inline void step() {
+        if (--left == 0)
+            _sample();
+    }
+
+    // clears the host report line, call before printing to the screen
+    void done() {
+#ifndef __mos6502__
+        if (shown)
+            fprintf(stderr, "\r\033[K");
+        shown = false;
+#endif
+    }
+
+    void _sample() {
+        left = PERIOD;
+        count += PERIOD;
+        const aoc64_time_t now = aoc64_now();
+#ifdef __mos6502__
+        if ((aoc64_time_t)(now - last) >= FRAME_JIFFIES) {
+            last = now;
+            tick(++frame & (uint8_t)7);
+        }
+#else
+        if (tty && now - last >= REPORT_NS) {
+            last = now;
+            _report(now);
+        }
+#endif
+    }
+
+#ifndef __mos6502__
+    void _report(const aoc64_time_t now) {
+        const double rate = count / ((now - start) * 1e-9);
+        fprintf(stderr, "\r%lu %s, %.0f %s/s", (unsigned long)count, unit, rate, unit);
+        if (total > count)
+            fprintf(stderr, ", %u%%, ETA %.1f s", (unsigned)(100.0 * count / total), (total - count) / rate);
+        fprintf(stderr, "\033[K");
+        shown = true;
+    }
+#endif
+};
+
+#endif // __PROGRESS_H__
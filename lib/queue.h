@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <assert.h>
+#include "instrument.h"
 
 // The queue structure
 template <typename T, typename IType, uint16_t MaxSize>
@@ -12,6 +13,11 @@ struct Queue {
     IType front = 0;
     IType back = 0;
     IType count = 0;
+    // Memory footprint (see budget.h)
+    static const uint32_t ram_bytes = sizeof(arr) + sizeof(front) + sizeof(back) + sizeof(count);
+    static const uint32_t reu_bytes = 0;
+    // Statistics (see instrument.h)
+    AOC64_STATS("Queue", MaxSize, nullptr)
 
     // Removes and returns the front element
     T pop();
@@ -26,7 +32,7 @@ struct Queue {
     // Returns the number of elements
     IType size() const { return this->count; }
     // Clears the queue
-    void clear() { this->front = 0; this->back = 0; count = 0; }
+    void clear() { this->front = 0; this->back = 0; count = 0; AOC64_STAT(op(STAT_CLEAR)); AOC64_STAT(size(0)); }
 };
 
 
@@ -38,6 +44,8 @@ T Queue<T, IType, MaxSize>::pop() {
     if (++this->front == MaxSize)
         this->front = 0;
     this->count--;
+    AOC64_STAT(op(STAT_REMOVE));
+    AOC64_STAT(size(this->count));
     return item;
 }
 
@@ -49,6 +57,8 @@ void Queue<T, IType, MaxSize>::push(const T& item) {
     if (++this->back == MaxSize)
         this->back = 0;
     this->count++;
+    AOC64_STAT(op(STAT_INSERT));
+    AOC64_STAT(size(this->count));
 }
 
 template <typename T, typename IType, uint16_t MaxSize>
@@ -61,6 +71,8 @@ T Queue<T, IType, MaxSize>::popBack() {
         this->back--;
     const T item = this->arr[this->back];
     this->count--;
+    AOC64_STAT(op(STAT_REMOVE));
+    AOC64_STAT(size(this->count));
     return item;
 }
 
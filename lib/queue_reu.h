@@ -13,6 +13,9 @@ struct QueueREU {
     IType front = 0;
     IType back = 0;
     IType count = 0;
+    // Memory footprint (see budget.h)
+    static const uint32_t ram_bytes = sizeof(arr) + sizeof(front) + sizeof(back) + sizeof(count);
+    static const uint32_t reu_bytes = 0;
 
     // Initializes the queue on the REU, needs to be called before first use
     void init();
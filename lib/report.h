@@ -0,0 +1,44 @@
+#ifndef __REPORT_H__
+#define __REPORT_H__
+
+#include <stdint.h>
+
+// Reports (e.g. container statistics) printed by finish() at the end of the run.
+// Each report is a callback taking an opaque context pointer (usually the object itself).
+typedef void (*report_fn)(const void* ctx);
+
+constexpr uint8_t MAX_REPORTS = 8;
+static struct {
+    report_fn fn[MAX_REPORTS];
+    const void* ctx[MAX_REPORTS];
+    uint8_t count;
+} _reports;
+
+// Registers a report to be printed by finish(), false (not registered) when all MAX_REPORTS are taken
+static inline bool at_finish(const report_fn fn, const void* const ctx) {
+    if (_reports.count == MAX_REPORTS)
+        return false;
+    _reports.fn[_reports.count] = fn;
+    _reports.ctx[_reports.count++] = ctx;
+    return true;
+}
+
+// Unregisters the reports of ctx, for objects that go away before finish()
+static inline void cancel_reports(const void* const ctx) {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < _reports.count; ++i) {
+        if (_reports.ctx[i] == ctx)
+            continue;
+        _reports.fn[n] = _reports.fn[i];
+        _reports.ctx[n++] = _reports.ctx[i];
+    }
+    _reports.count = n;
+}
+
+// Prints all registered reports in the order of registration
+static inline void print_reports() {
+    for (uint8_t i = 0; i < _reports.count; ++i)
+        _reports.fn[i](_reports.ctx[i]);
+}
+
+#endif // __REPORT_H__
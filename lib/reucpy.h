@@ -4,12 +4,15 @@
 #include <stdint.h>
 #include <string.h>
 #include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
 
 #define RAM2REU 0x90 // Copy from C64 RAM to REU memory
 #define REU2RAM 0x91 // Copy from REU memory to C64 RAM
 #define REUSWAP 0x92 // Swap contents between REU and C64 RAM addresses
 #define REUCMP  0x93 // Compare contents between REU and C64 RAM
 
+#ifdef __mos6502__
 // unsigned 24 bit integer type
 typedef unsigned _BitInt(24) reu_addr_t;
 
@@ -18,6 +21,10 @@ static volatile uintptr_t* const reu_c64_addr = (uintptr_t*)0xDF02;
 static volatile reu_addr_t* const reu_cart_addr = (reu_addr_t*)0xDF04;
 static volatile uint16_t* const reu_xfer_length = (uint16_t*)0xDF07;
 static volatile uint8_t* const reu_address_ctl = (uint8_t*)0xDF0A;
+#else
+// host stand-in for the 24 bit REU address
+typedef uint32_t reu_addr_t;
+#endif
 
 // Like memcpy, but copies data between C64 RAM and REU.
 // size: number of bytes to write. Note that 0 is interpreted as 65536 bytes!
@@ -59,6 +66,7 @@ void reu_clear(uint16_t nbanks);
 const uint16_t banks_needed(uint32_t size);
 
 
+#ifdef __mos6502__
 void reucpy(void* c64_addr, reu_addr_t reu_addr, uint16_t size, uint8_t direction)
 {
   // Call reu_init() first if this assert() triggers, or if manually
@@ -122,6 +130,120 @@ const uint16_t reu_init()
   return 256; // Full 16MB of REU available
 }
 
+#else
+// Software REU for host builds: 16MB of zeroed memory allocated on first use.
+// The transfer counters allow comparing the DMA traffic of the C64 builds.
+static uint8_t* _reu_mem = nullptr;
+static uint32_t reu_transfers = 0;
+static uint64_t reu_transfer_bytes = 0;
+
+// Transfer trace: with AOC64_REU_TRACE=<file> every transfer is appended to <file>, replay it with
+// tools/reu_replay.cpp. The file starts with "REUT", a version byte and 3 zero bytes, followed by
+// one 8 byte little endian record per transfer:
+//   op, REU address (24 bit), RAM address (low 16 bits), length (0 means 65536 bytes)
+// op is 0 for RAM to REU and 1 for REU to RAM, plus the address control bits of the REU:
+// 0x80 fixed RAM address (reuset) and 0x40 fixed REU address (memset_reu).
+#define REU_TRACE_STORE 0x00
+#define REU_TRACE_LOAD  0x01
+#define REU_TRACE_FIX_RAM 0x80
+#define REU_TRACE_FIX_REU 0x40
+#define REU_TRACE_VERSION 1
+
+static FILE* _reu_trace_file = nullptr;
+static int8_t _reu_trace_state = 0; // 0 not checked yet, 1 tracing, -1 off
+
+// kept out of line and cold: inlined into _reu_length(), its register saves slowed down every transfer
+__attribute__((noinline, cold)) static void _reu_trace(const uint8_t op, const reu_addr_t reu_addr,
+                                                      const void* const ram_addr, const uint16_t size) {
+    if (_reu_trace_state == 0) {
+        const char* path = getenv("AOC64_REU_TRACE");
+        _reu_trace_state = -1;
+        if (path == nullptr || *path == 0)
+            return;
+        _reu_trace_file = fopen(path, "wb");
+        if (_reu_trace_file == nullptr) {
+            fprintf(stderr, "cannot write the REU trace to %s\n", path);
+            return;
+        }
+        setvbuf(_reu_trace_file, nullptr, _IOFBF, 1 << 20);
+        const uint8_t header[8] = { 'R', 'E', 'U', 'T', REU_TRACE_VERSION, 0, 0, 0 };
+        fwrite(header, 1, sizeof(header), _reu_trace_file);
+        _reu_trace_state = 1;
+    }
+    if (_reu_trace_state < 0)
+        return;
+    const uintptr_t ram = (uintptr_t)ram_addr;
+    const uint8_t record[8] = { op, (uint8_t)reu_addr, (uint8_t)(reu_addr >> 8), (uint8_t)(reu_addr >> 16),
+                                (uint8_t)ram, (uint8_t)(ram >> 8), (uint8_t)size, (uint8_t)(size >> 8) };
+    fwrite(record, 1, sizeof(record), _reu_trace_file);
+}
+
+static inline uint8_t* _reu_ptr(const reu_addr_t reu_addr) {
+    if (_reu_mem == nullptr) {
+        _reu_mem = (uint8_t*)calloc(0x1000000, 1);
+        assert(_reu_mem != nullptr);
+    }
+    return _reu_mem + (reu_addr & 0xFFFFFF);
+}
+
+// counts (and traces) the transfer and returns its length (0 means 65536 bytes)
+// kept out of line, otherwise gcc warns about 65536 byte copies for sizes it can't prove non-zero
+__attribute__((noinline)) static uint32_t _reu_length(const uint8_t op, const reu_addr_t reu_addr,
+                                                      const void* const ram_addr, const uint16_t size) {
+    const uint32_t len = size ? size : 0x10000;
+    ++reu_transfers;
+    reu_transfer_bytes += len;
+    assert((reu_addr & 0xFFFFFF) + len <= 0x1000000);
+    if (_reu_trace_state >= 0)
+        _reu_trace(op, reu_addr, ram_addr, size);
+    return len;
+}
+
+void reucpy(void* c64_addr, reu_addr_t reu_addr, uint16_t size, uint8_t direction)
+{
+  assert(direction == RAM2REU || direction == REU2RAM || !"REU command not supported on the host");
+  const uint32_t len = _reu_length(direction == RAM2REU ? REU_TRACE_STORE : REU_TRACE_LOAD, reu_addr, c64_addr, size);
+  if (direction == RAM2REU)
+    memcpy(_reu_ptr(reu_addr), c64_addr, len);
+  else
+    memcpy(c64_addr, _reu_ptr(reu_addr), len);
+}
+
+void reuset(reu_addr_t reu_addr, uint8_t val, uint16_t size)
+{
+  const uint32_t len = _reu_length(REU_TRACE_STORE | REU_TRACE_FIX_RAM, reu_addr, &val, size);
+  memset(_reu_ptr(reu_addr), val, len);
+}
+
+void memset_reu(reu_addr_t reu_addr, uintptr_t addr, uint16_t size)
+{
+  const uint32_t len = _reu_length(REU_TRACE_LOAD | REU_TRACE_FIX_REU, reu_addr, (void *)addr, size);
+  memset((void *)addr, *_reu_ptr(reu_addr), len);
+}
+
+void memcpy_reu(void* dest, const void* src, uint16_t count) {
+  reucpy((void *)src, 0, count, RAM2REU);
+  reucpy(dest, 0, count, REU2RAM);
+}
+
+// prints the transfer counters to stderr at exit when AOC64_STATS is set (read by bench/bench.py)
+// and completes the trace file
+static struct _REUStats {
+    ~_REUStats() {
+        if (getenv("AOC64_STATS"))
+            fprintf(stderr, "reu: %u transfers, %llu bytes\n", reu_transfers, (unsigned long long)reu_transfer_bytes);
+        if (_reu_trace_file != nullptr)
+            fclose(_reu_trace_file);
+    }
+} _reu_stats;
+
+const uint16_t reu_init()
+{
+  _reu_ptr(0);
+  return 256; // Full 16MB of REU available
+}
+#endif
+
 void reu_clear(uint16_t nbanks) {
     for (uint16_t bank = 0; bank < nbanks; ++bank) {
         reuset((reu_addr_t)bank << 16, 0, 0);
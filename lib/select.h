@@ -0,0 +1,120 @@
+#ifndef __SELECT_H__
+#define __SELECT_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// Selection of the k-th smallest element (k = 0 for the smallest), e.g. a median, without sorting
+// and without allocation or recursion:
+// - select(): quickselect in place, for any type with the < operator. The pivot is the median of
+//   three and the partition three-way, so repeated values cost nothing. Should the ranges not
+//   shrink fast enough (adversarial input), the rest is heapsorted: linear on average, O(n log n)
+//   at worst.
+// - select_counting(): for integers in a known range, counts the values instead and leaves the
+//   array untouched, O(n + RANGE) when the range is below RANGE, one more pass over the values
+//   per factor of RANGE above.
+
+template <typename T>
+static inline void _select_swap(T& a, T& b) {
+    const T t = a;
+    a = b;
+    b = t;
+}
+
+// Heapsorts a[0..n-1], the fallback of select()
+template <typename T>
+static void _select_heapsort(T* const a, const size_t n) {
+    for (size_t end = n, start = n / 2; end > 1;) {
+        // builds the heap (start > 0), then moves its top behind it
+        size_t root;
+        if (start > 0) {
+            root = --start;
+        } else {
+            _select_swap(a[0], a[--end]);
+            root = 0;
+        }
+        for (size_t child; (child = 2 * root + 1) < end; root = child) {
+            if (child + 1 < end && a[child] < a[child + 1])
+                ++child;
+            if (!(a[root] < a[child]))
+                break;
+            _select_swap(a[root], a[child]);
+        }
+    }
+}
+
+// The k-th smallest of a[0..n-1] (k < n), reorders a so that it is at a[k]
+template <typename T>
+T select(T* const a, const size_t n, const size_t k) {
+    size_t lo = 0, hi = n - 1;
+    // about 2 log2(n) partitions before the fallback
+    uint8_t rounds = 0;
+    for (size_t m = n; m > 1; m >>= 1)
+        rounds += 2;
+    while (lo < hi) {
+        if (rounds-- == 0) {
+            _select_heapsort(a + lo, hi - lo + 1);
+            break;
+        }
+        // median of three
+        const size_t mid = lo + (hi - lo) / 2;
+        if (a[mid] < a[lo])
+            _select_swap(a[mid], a[lo]);
+        if (a[hi] < a[lo])
+            _select_swap(a[hi], a[lo]);
+        if (a[hi] < a[mid])
+            _select_swap(a[hi], a[mid]);
+        const T pivot = a[mid];
+        // three-way partition: a[lo..lt-1] < pivot, a[lt..gt] == pivot, a[gt+1..hi] > pivot
+        size_t lt = lo, i = lo, gt = hi;
+        while (i <= gt) {
+            if (a[i] < pivot)
+                _select_swap(a[lt++], a[i++]);
+            else if (pivot < a[i])
+                _select_swap(a[i], a[gt--]);
+            else
+                ++i;
+        }
+        if (k < lt)
+            hi = lt - 1;
+        else if (k > gt)
+            lo = gt + 1;
+        else
+            return a[k];
+    }
+    return a[k];
+}
+
+// The k-th smallest of a[0..n-1] (k < n), all of them integers in lo .. hi, counted in counts
+// (cleared here, C must hold n)
+template <typename T, typename C, size_t RANGE>
+T select_counting(const T* const a, const size_t n, size_t k, const T lo, const T hi, C (&counts)[RANGE]) {
+    static_assert(RANGE > 1 && (RANGE & (RANGE - 1)) == 0, "RANGE must be a power of 2");
+    uint8_t bits = 0;
+    while (((size_t)1 << bits) < RANGE)
+        ++bits;
+    // each pass counts the values base .. base + (RANGE << shift) - 1 (from lo) in buckets of 1 << shift
+    uint8_t shift = 0;
+    while (((size_t)(hi - lo) >> shift) >= RANGE)
+        ++shift;
+    size_t base = 0;
+    for (;;) {
+        memset(counts, 0, sizeof(counts));
+        for (size_t i = 0; i < n; ++i) {
+            // values below base wrap around to out of range
+            const size_t v = ((size_t)(a[i] - lo) - base) >> shift;
+            if (v < RANGE)
+                ++counts[v];
+        }
+        size_t bucket = 0;
+        while (k >= counts[bucket])
+            k -= counts[bucket++];
+        base += bucket << shift;
+        if (shift == 0)
+            return (T)(lo + base);
+        shift = shift > bits ? shift - bits : 0;
+    }
+}
+
+#endif // __SELECT_H__
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <assert.h>
+#include "instrument.h"
 
 
 // The stack structure
@@ -11,17 +12,22 @@ struct Stack {
     // Data
 	T arr[MAX_SIZE];
     IType sp = 0;
+    // Memory footprint (see budget.h)
+    static const uint32_t ram_bytes = sizeof(arr) + sizeof(sp);
+    static const uint32_t reu_bytes = 0;
+    // Statistics (see instrument.h)
+    AOC64_STATS("Stack", MAX_SIZE, nullptr)
 
     // Removes and returns the top element
-    T pop() { assert(this->sp > 0); return this->arr[--this->sp]; }
+    T pop() { assert(this->sp > 0); AOC64_STAT(op(STAT_REMOVE)); AOC64_STAT(size(this->sp - 1)); return this->arr[--this->sp]; }
     // Returns the top element without removing it
     T peek() const { return this->arr[this->sp - 1]; }
     // Adds an element to the top
-    void push(const T& item) { assert(this->sp < MAX_SIZE); this->arr[this->sp++] = item; }
+    void push(const T& item) { assert(this->sp < MAX_SIZE); this->arr[this->sp++] = item; AOC64_STAT(op(STAT_INSERT)); AOC64_STAT(size(this->sp)); }
     // Returns the number of elements
     IType size() const { return this->sp; }
     // Clears the stack
-    void clear() { this->sp = 0; }
+    void clear() { this->sp = 0; AOC64_STAT(op(STAT_CLEAR)); AOC64_STAT(size(0)); }
 };
 
 #endif //__STACK_H__
@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <assert.h>
 #include "reucpy.h"
+#include "instrument.h"
 
 
 // The stack structure. Before use call the Init(base_addr) method
@@ -16,6 +17,11 @@ struct StackREU {
     reu_addr_t end_addr;
     static const uint16_t record_size = (uint16_t)sizeof(T);
     static const reu_addr_t memory_size = (reu_addr_t)MAX_SIZE*record_size;
+    // Memory footprint (see budget.h)
+    static const uint32_t ram_bytes = sizeof(record) + sizeof(sp) + sizeof(base_addr) + sizeof(end_addr);
+    static const uint32_t reu_bytes = memory_size;
+    // Statistics (see instrument.h)
+    AOC64_STATS("StackREU", MAX_SIZE, nullptr)
 
     // Initializes the stack on the REU, needs to be called before first use
     void init(reu_addr_t addr) { this->base_addr = addr; this->end_addr = addr + memory_size; this->sp = 0; };
@@ -32,7 +38,7 @@ struct StackREU {
     // Returns the number of elements
     IType size() const { return this->sp; }
     // Clears the stack (only resets the stack pointer, memory is not actually erased)
-    void clear() { this->sp = 0; }
+    void clear() { this->sp = 0; AOC64_STAT(op(STAT_CLEAR)); AOC64_STAT(size(0)); }
 
     // Internal, do not use
     reu_addr_t _get_addr(const IType i) const { assert(i < MAX_SIZE); return this->base_addr + (reu_addr_t)this->record_size*i; }
@@ -43,6 +49,9 @@ struct StackREU {
 template <typename T, typename IType, uint16_t MAX_SIZE>
 T StackREU<T, IType, MAX_SIZE>::pop() {
     reucpy((void *)&this->record, _get_addr(--this->sp), sizeof(T), REU2RAM);
+    AOC64_STAT(op(STAT_REMOVE));
+    AOC64_STAT(size(this->sp));
+    AOC64_STAT(reu(sizeof(T)));
 	return this->record;
 }
 
@@ -50,12 +59,17 @@ T StackREU<T, IType, MAX_SIZE>::pop() {
 template <typename T, typename IType, uint16_t MAX_SIZE>
 void StackREU<T, IType, MAX_SIZE>::popInto(T* const item) {
     reucpy((void *)item, _get_addr(--this->sp), sizeof(T), REU2RAM);
+    AOC64_STAT(op(STAT_REMOVE));
+    AOC64_STAT(size(this->sp));
+    AOC64_STAT(reu(sizeof(T)));
 }
 
 
 template <typename T, typename IType, uint16_t MAX_SIZE>
 T StackREU<T, IType, MAX_SIZE>::get(const IType i) {
     reucpy((void *)&this->record, _get_addr(i), sizeof(T), REU2RAM);
+    AOC64_STAT(op(STAT_FIND));
+    AOC64_STAT(reu(sizeof(T)));
 	return this->record;
 }
 
@@ -63,12 +77,17 @@ T StackREU<T, IType, MAX_SIZE>::get(const IType i) {
 template <typename T, typename IType, uint16_t MAX_SIZE>
 void StackREU<T, IType, MAX_SIZE>::getInto(const IType i, T* item) const {
     reucpy((void *)item, _get_addr(i), sizeof(T), REU2RAM);
+    AOC64_STAT(op(STAT_FIND));
+    AOC64_STAT(reu(sizeof(T)));
 }
 
 
 template <typename T, typename IType, uint16_t MAX_SIZE>
 void StackREU<T, IType, MAX_SIZE>::push(const T& item) {
     reucpy((void *)&item, _get_addr(this->sp++), sizeof(T), RAM2REU);
+    AOC64_STAT(op(STAT_INSERT));
+    AOC64_STAT(size(this->sp));
+    AOC64_STAT(reu(sizeof(T)));
 }
 
 #endif //__STACK_REU_H__
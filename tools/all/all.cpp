@@ -0,0 +1,132 @@
+// aoc64_all: the host builds of every day in one executable, run in parallel
+//
+//     build/aoc64_all               # every day, one thread per core
+//     build/aoc64_all -j 4 15 23    # days 15 and 23 on up to 4 threads
+//
+// A pool of threads takes the days longest first, by their C64 time in the table of the README
+// (which orders the host times too), so the wall time approaches that of the slowest day.
+// The output of each day is collected and printed in day order, followed by the time of each day.
+// AOC64_INPUT, AOC64_REU_TRACE and AOC64_STATS are ignored, they would apply to every day at once.
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "all.h"
+
+struct Day {
+    const char* name;
+    day_fn fn;
+    double c64_seconds;
+    std::string output;
+    double seconds;
+    unsigned thread;
+};
+
+// registered from the static initializers of the day wrappers, hence not a plain global
+static std::vector<Day>& days() {
+    static std::vector<Day> registered;
+    return registered;
+}
+
+bool aoc64_register(const char* const name, const day_fn fn, const double c64_seconds) {
+    days().push_back({name, fn, c64_seconds, {}, 0.0, 0});
+    return true;
+}
+
+thread_local std::string* aoc64_output = nullptr;
+
+int aoc64_printf(const char* const fmt, ...) {
+    va_list args, again;
+    va_start(args, fmt);
+    va_copy(again, args);
+    int n;
+    if (aoc64_output == nullptr) {
+        n = vprintf(fmt, args);
+    } else {
+        char buffer[256];
+        n = vsnprintf(buffer, sizeof(buffer), fmt, args);
+        if (n < (int)sizeof(buffer)) {
+            aoc64_output->append(buffer, n > 0 ? n : 0);
+        } else {
+            const size_t size = aoc64_output->size();
+            aoc64_output->resize(size + n);
+            vsnprintf(&(*aoc64_output)[size], n + 1, fmt, again);
+        }
+    }
+    va_end(again);
+    va_end(args);
+    return n;
+}
+
+static double seconds_since(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<bool> selected(100, argc == 1);
+    bool any = false;
+    for (int i = 1; i < argc; ++i) {
+        const int day = atoi(argv[i]);
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            threads = atoi(argv[++i]);
+        } else if (day > 0 && day < 100) {
+            selected[day] = any = true;
+        } else {
+            fprintf(stderr, "usage: %s [-j THREADS] [DAY ...]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (!any)
+        selected.assign(selected.size(), true);
+    unsetenv("AOC64_INPUT");
+    unsetenv("AOC64_REU_TRACE");
+    unsetenv("AOC64_STATS");
+
+    std::vector<Day>& all = days();
+    std::sort(all.begin(), all.end(), [](const Day& a, const Day& b) { return strcmp(a.name, b.name) < 0; });
+    std::vector<Day*> queue;
+    for (Day& d : all)
+        if (selected[atoi(d.name + 3)])
+            queue.push_back(&d);
+    std::stable_sort(queue.begin(), queue.end(), [](const Day* a, const Day* b) { return a->c64_seconds > b->c64_seconds; });
+    threads = std::min<unsigned>(threads, queue.size());
+
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            for (size_t i; (i = next++) < queue.size();) {
+                Day& d = *queue[i];
+                aoc64_output = &d.output;
+                const auto day_start = std::chrono::steady_clock::now();
+                d.fn();
+                d.seconds = seconds_since(day_start);
+                d.thread = t;
+                aoc64_output = nullptr;
+            }
+        });
+    }
+    for (std::thread& t : pool)
+        t.join();
+    const double wall = seconds_since(start);
+
+    double sum = 0, slowest = 0;
+    for (const Day& d : all) {
+        if (!selected[atoi(d.name + 3)])
+            continue;
+        printf("== %s\n%s", d.name, d.output.c_str());
+        if (!d.output.empty() && d.output.back() != '\n')
+            printf("\n");
+        sum += d.seconds;
+        slowest = std::max(slowest, d.seconds);
+    }
+    printf("\n%-6s %10s %7s %10s\n", "day", "host (s)", "thread", "C64 (s)");
+    for (const Day& d : all)
+        if (selected[atoi(d.name + 3)])
+            printf("%-6s %10.6f %7u %10.2f\n", d.name, d.seconds, d.thread, d.c64_seconds);
+    printf("\nwall time %.6f s on %u threads, %.6f s for all days one after another, %.6f s for the slowest\n",
+           wall, threads, sum, slowest);
+    return 0;
+}
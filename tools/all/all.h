@@ -0,0 +1,47 @@
+#ifndef __ALL_H__
+#define __ALL_H__
+
+// Shared part of aoc64_all, the host executable that links every day (see tools/all/all.cpp).
+// Each day is compiled from a generated wrapper (tools/all/day.cpp.in) that includes this header,
+// then the day's main.cpp inside a namespace of its own, so the globals of the days don't clash
+// and main() becomes dayNN::main(). Everything the days and lib/ include from the system is
+// included here first, outside the namespaces, where the include guards keep it.
+#include <algorithm>
+#include <assert.h>
+#include <chrono>
+#include <cmath>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <set>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+// The output of a day goes to the buffer of the thread running it, printed in day order at the end
+int aoc64_printf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+extern thread_local std::string* aoc64_output;
+
+typedef int (*day_fn)();
+
+// Calls the main() of a day, with no arguments for those taking argc and argv (batch.h)
+static inline int aoc64_call(int (*const main)()) { return main(); }
+static inline int aoc64_call(int (*const main)(int, char**)) {
+    static char name[] = "aoc64_all";
+    char* argv[] = {name, nullptr};
+    return main(1, argv);
+}
+
+// Registers a day to be run, c64_seconds (its time in the table of the README) orders the runs
+bool aoc64_register(const char* name, day_fn fn, double c64_seconds);
+
+#endif // __ALL_H__
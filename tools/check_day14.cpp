@@ -0,0 +1,108 @@
+// Checks the --steps n --mod p answers of day 14 (difference_mod() of 2021/day14/matrix.h) against
+// exact big integer counts, for the compiled-in input of day 14, step by step up to the largest n:
+//
+//     build/check_day14                      # 10 .. 120000 steps modulo 1000000007
+//     build/check_day14 130000 998244353
+//
+// The pair counts at most double at each step, so a count of n steps has about n bits: up to
+// 130000 steps (BigUInt<4096>), about 10 s for the example, longer with more pairs.
+// Exit status is 1 on any difference.
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "linrec.h"
+#include "matrix.h"
+#if __has_include("input.h") && !defined(AOC64_EXAMPLE_INPUT)
+  #include "input.h"
+#else
+  #include "input.example.h"
+#endif
+
+typedef BigUInt<4096> Count;
+constexpr uint8_t SIDE = ELEMENTS + 1, END = ELEMENTS;
+
+static Count counts_a[SIDE * SIDE], counts_b[SIDE * SIDE];
+static Count* pairs = counts_a;  // the counts of the pairs after the current step
+static Count* next_pairs = counts_b;
+
+static int compare(const Count& a, const Count& b) {
+    if (a.n != b.n)
+        return a.n < b.n ? -1 : 1;
+    for (uint16_t i = a.n; i-- > 0;)
+        if (a.limb[i] != b.limb[i])
+            return a.limb[i] < b.limb[i] ? -1 : 1;
+    return 0;
+}
+
+static uint64_t modulo(const Count& a, const uint64_t p) {
+    uint64_t r = 0;
+    for (uint16_t i = a.n; i-- > 0;)
+        r = ((r << 32) | a.limb[i]) % p;
+    return r;
+}
+
+// (max - min) mod p of the exact element counts, the first element of each pair (END closes the polymer)
+static uint64_t exact_difference_mod(const uint64_t p) {
+    static Count counts[ELEMENTS];
+    for (Count& c : counts)
+        c = Count(0);
+    for (uint16_t k = 0; k < SIDE * SIDE; ++k)
+        if (pairs[k].n)
+            counts[k / SIDE] += pairs[k];
+    int8_t min = -1, max = -1;
+    for (int8_t i = 0; i < ELEMENTS; ++i) {
+        if (counts[i].n == 0) continue;
+        if (min < 0 || compare(counts[i], counts[min]) < 0) min = i;
+        if (max < 0 || compare(counts[i], counts[max]) > 0) max = i;
+    }
+    assert(!counts[max].overflow);
+    return (modulo(counts[max], p) + p - modulo(counts[min], p)) % p;
+}
+
+int main(int argc, char** argv) {
+    const uint64_t last = argc > 1 ? strtoull(argv[1], nullptr, 10) : 120000;
+    const uint64_t p = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1000000007;
+    if (last < 1 || last > 130000 || p < 2 || p > UINT32_MAX) {
+        fprintf(stderr, "usage: %s [steps (1 .. 130000) [p (2 .. 2^32-1)]]\n", argv[0]);
+        return 2;
+    }
+    int8_t insert[SIDE * SIDE];
+    memset(insert, -1, sizeof(insert));
+    for (size_t i = 0; i < n_rules; ++i)
+        insert[(rules[i][0][0] - 'A') * SIDE + rules[i][0][1] - 'A'] = rules[i][1][0] - 'A';
+    const size_t len = strlen(polymer_template);
+    for (size_t i = 0; i < len; ++i)
+        pairs[(polymer_template[i] - 'A') * SIDE + (i + 1 < len ? polymer_template[i + 1] - 'A' : END)] += Count(1);
+
+    const uint64_t checks[] = {10, 40, 1000, 10000, 50000, 100000, 110000, 120000, 130000};
+    uint8_t next_check = 0;
+    int failures = 0;
+    for (uint64_t step = 1; step <= last; ++step) {
+        for (uint16_t k = 0; k < SIDE * SIDE; ++k)
+            next_pairs[k] = Count(0);
+        for (uint16_t k = 0; k < SIDE * SIDE; ++k) {
+            if (pairs[k].n == 0)
+                continue;
+            const int8_t c = insert[k];
+            if (c < 0) {
+                next_pairs[k] += pairs[k];
+            } else {
+                next_pairs[k / SIDE * SIDE + c] += pairs[k];
+                next_pairs[c * SIDE + k % SIDE] += pairs[k];
+            }
+        }
+        Count* const t = pairs;
+        pairs = next_pairs;
+        next_pairs = t;
+        const bool check = next_check < sizeof(checks) / sizeof(checks[0]) && step == checks[next_check];
+        next_check += check;
+        if (!check && step != last)
+            continue;
+        const uint64_t exact = exact_difference_mod(p), matrix = difference_mod(polymer_template, rules, n_rules, step, p);
+        printf("steps %llu mod %llu: %llu exact, %llu from the matrix powers%s\n", (unsigned long long)step,
+               (unsigned long long)p, (unsigned long long)exact, (unsigned long long)matrix, exact == matrix ? "" : "  FAIL");
+        fflush(stdout);
+        failures += exact != matrix;
+    }
+    return failures ? 1 : 0;
+}
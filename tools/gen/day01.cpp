@@ -0,0 +1,23 @@
+// Day 1: sonar sweep, a random walk of depths
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n depths", 2000);
+    std::vector<uint16_t> depths(g.n);
+    int32_t depth = g.range(100, 200);
+    for (uint16_t& v : depths) {
+        depth += g.range(-10, 20);
+        if (depth < 0 || depth > 65535)
+            depth = g.range(100, 200);
+        v = depth;
+    }
+    if (!g.header) {
+        for (const uint16_t v : depths)
+            g.print("%u\n", v);
+        return 0;
+    }
+    g.print("#include <stdint.h>\n\nstatic const uint16_t lines[] = {");
+    for (size_t i = 0; i < depths.size(); ++i)
+        g.print("%s%u", i == 0 ? "" : i % 20 ? "," : ",\n", depths[i]);
+    g.print("};\n");
+}
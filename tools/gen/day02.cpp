@@ -0,0 +1,27 @@
+// Day 2: dive, forward/down/up commands that never take the submarine (or its aim) above the surface
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n commands", 1000);
+    std::vector<std::string> lines;
+    int64_t depth = 0, aim = 0;
+    char line[16];
+    for (uint64_t i = 0; i < g.n; ++i) {
+        const int x = g.range(1, 9);
+        const uint64_t c = g.below(3);
+        if (c == 0) {
+            snprintf(line, sizeof(line), "forward %d", x);
+            depth += aim * x;
+        } else if (c == 1 || depth < x || aim < x) {
+            snprintf(line, sizeof(line), "down %d", x);
+            aim += x;
+        } else {
+            snprintf(line, sizeof(line), "up %d", x);
+            aim -= x;
+        }
+        lines.push_back(line);
+    }
+    g.lines(lines, "const char* input[]");
+    if (g.header)
+        g.print("\nconstexpr %s input_len = sizeof(input) / sizeof(input[0]);\n", fit("uint16_t", g.n));
+}
@@ -0,0 +1,21 @@
+// Day 3: binary diagnostic, distinct numbers of -d bits (the life support rating needs them distinct)
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n numbers", 1000, 12);
+    g.check(g.d >= 2 && g.d <= 24 && g.n >= 1 && g.n <= (1ull << g.d), "-n must be at most 2^d, 2 <= d <= 24");
+    std::vector<uint32_t> all(1ull << g.d);
+    for (uint32_t i = 0; i < all.size(); ++i)
+        all[i] = i;
+    g.shuffle(all.data(), all.size());
+    std::vector<std::string> lines;
+    for (uint64_t i = 0; i < g.n; ++i) {
+        std::string s;
+        for (int b = g.d - 1; b >= 0; --b)
+            s += all[i] >> b & 1 ? '1' : '0';
+        lines.push_back(s);
+    }
+    if (g.header)
+        g.print("#include <stdint.h>\n\nconstexpr %s input_len = %llu;\n", fit("uint16_t", g.n), (unsigned long long)g.n);
+    g.lines(lines, "const char* input[input_len]");
+}
@@ -0,0 +1,33 @@
+// Day 4: giant squid, every number 0..99 drawn once and -n boards of 25 distinct numbers
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n boards", 100);
+    g.check(g.n >= 1 && g.n <= 255, "-n must be 1..255");
+    uint8_t numbers[100];
+    for (uint8_t i = 0; i < 100; ++i)
+        numbers[i] = i;
+    g.shuffle(numbers, 100);
+    g.print(g.header ? "#include <stdint.h>\n\nconst uint8_t numbers[] = {" : "");
+    for (uint8_t i = 0; i < 100; ++i)
+        g.print("%s%u", i ? "," : "", numbers[i]);
+    g.print(g.header ? "};\n\nconst uint8_t bingos[][5][5] = {\n" : "\n");
+    uint8_t board[100];
+    for (uint8_t i = 0; i < 100; ++i)
+        board[i] = i;
+    for (uint64_t b = 0; b < g.n; ++b) {
+        g.shuffle(board, 100);
+        for (uint8_t r = 0; r < 5; ++r) {
+            if (g.header)
+                g.print(r ? " {" : "{{");
+            else if (r == 0)
+                g.print("\n");
+            for (uint8_t c = 0; c < 5; ++c)
+                g.print(g.header ? "%s%2u" : "%s%2u", c ? (g.header ? "," : " ") : "", board[5 * r + c]);
+            if (g.header)
+                g.print(r < 4 ? "},\n" : b + 1 < g.n ? "}},\n" : "}}\n};\n");
+            else
+                g.print("\n");
+        }
+    }
+}
@@ -0,0 +1,34 @@
+// Day 5: hydrothermal venture, horizontal, vertical and diagonal lines in a -d x -d field
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n lines", 500, 1000);
+    g.check(g.d >= 2 && g.d <= 32767, "-d must be 2..32767");
+    if (g.header)
+        g.print("#include <stdint.h>\n\nint16_t lines[][4] = {\n");
+    for (uint64_t i = 0; i < g.n; ++i) {
+        int64_t x1 = g.below(g.d), y1 = g.below(g.d), x2 = x1, y2 = y1;
+        const uint64_t kind = g.below(3);
+        if (kind == 0) {
+            while (x2 == x1)
+                x2 = g.below(g.d);
+        } else if (kind == 1) {
+            while (y2 == y1)
+                y2 = g.below(g.d);
+        } else {
+            // as long as the field allows in both directions
+            const int64_t dx = g.chance(0.5) ? 1 : -1, dy = g.chance(0.5) ? 1 : -1;
+            const int64_t room_x = dx > 0 ? g.d - 1 - x1 : x1, room_y = dy > 0 ? g.d - 1 - y1 : y1;
+            const int64_t len = g.range(0, room_x < room_y ? room_x : room_y);
+            x2 = x1 + dx * len;
+            y2 = y1 + dy * len;
+        }
+        if (g.header)
+            g.print("{%lld,%lld,%lld,%lld}%s\n", (long long)x1, (long long)y1, (long long)x2, (long long)y2,
+                    i + 1 < g.n ? "," : "};");
+        else
+            g.print("%lld,%lld -> %lld,%lld\n", (long long)x1, (long long)y1, (long long)x2, (long long)y2);
+    }
+    if (g.header)
+        g.print("\nconstexpr %s n_lines = sizeof(lines)/sizeof(lines[0]);\n", fit("int16_t", g.n));
+}
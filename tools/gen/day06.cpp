@@ -0,0 +1,22 @@
+// Day 6: lanternfish, -n fish with timers 1..5
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n fish", 300);
+    uint64_t timers[9] = {};
+    for (uint64_t i = 0; i < g.n; ++i) {
+        const uint64_t t = g.range(1, 5);
+        ++timers[t];
+        if (!g.header)
+            g.print("%s%llu", i ? "," : "", (unsigned long long)t);
+    }
+    if (!g.header) {
+        g.print("\n");
+        return 0;
+    }
+    // the header holds the number of fish per timer value
+    g.print("#include <stdint.h>\n\nuint64_t timers[] = {");
+    for (uint8_t t = 0; t < 9; ++t)
+        g.print("%s%llu", t ? ", " : "", (unsigned long long)timers[t]);
+    g.print("};\n\nconstexpr %s timers_len = %llu;\n", fit("uint8_t", g.n), (unsigned long long)g.n);
+}
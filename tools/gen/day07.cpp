@@ -0,0 +1,17 @@
+// Day 7: treachery of whales, -n crab positions in 0 .. -d, crowded towards the low end like the puzzle
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n crabs", 1000, 2000);
+    g.check(g.d >= 1 && g.d <= 32767, "-d must be 1..32767");
+    if (g.header)
+        g.print("#include <stdint.h>\n\nconst int16_t crabs[] = {");
+    for (uint64_t i = 0; i < g.n; ++i) {
+        const uint64_t a = g.below(g.d + 1), b = g.below(g.d + 1);
+        g.print("%s%llu", i == 0 ? "" : g.header && i % 20 == 0 ? ",\n" : ",", (unsigned long long)(a < b ? a : b));
+    }
+    if (g.header)
+        g.print("};\nconstexpr %s n_crabs = sizeof(crabs)/sizeof(crabs[0]);\n", fit("int16_t", g.n));
+    else
+        g.print("\n");
+}
@@ -0,0 +1,36 @@
+// Day 8: seven segment search, the ten digits of a display with randomly crossed wires
+#include "gen.h"
+
+static const char* const DIGITS[10] = {"abcefg", "cf", "acdeg", "acdfg", "bcdf",
+                                       "abdfg", "abdefg", "acf", "abcdefg", "abcdfg"};
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n displays", 200);
+    std::vector<std::string> lines;
+    for (uint64_t i = 0; i < g.n; ++i) {
+        char wires[7] = {'a', 'b', 'c', 'd', 'e', 'f', 'g'};
+        g.shuffle(wires, 7);
+        // a digit as lit on this display, in a random order of its segments
+        auto crossed = [&](const uint8_t digit) {
+            std::string s;
+            for (const char* c = DIGITS[digit]; *c; ++c)
+                s += wires[*c - 'a'];
+            g.shuffle(&s[0], s.size());
+            return s;
+        };
+        uint8_t order[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        g.shuffle(order, 10);
+        std::string line;
+        for (const uint8_t digit : order)
+            line += crossed(digit) + " ";
+        line += "|";
+        for (uint8_t k = 0; k < 4; ++k)
+            line += " " + crossed(g.below(10));
+        lines.push_back(line);
+    }
+    if (g.header)
+        g.print("#include <stdint.h>\n\n");
+    g.lines(lines, "const char* lines[]", "    ");
+    if (g.header)
+        g.print("\nconstexpr %s n_lines = sizeof(lines)/sizeof(lines[0]);\n", fit("uint8_t", g.n));
+}
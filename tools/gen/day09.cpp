@@ -0,0 +1,41 @@
+// Day 9: smoke basin, a -n x -d height map whose basins are walled off by 9s
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n width", 100, 100);
+    g.check(g.n >= 2 && g.d >= 2, "-n and -d must be at least 2");
+    // random heights cut by ridges of 9s along random rows and columns (with a few gaps)
+    std::vector<std::string> map(g.d, std::string(g.n, '0'));
+    for (uint64_t y = 0; y < g.d; ++y)
+        for (uint64_t x = 0; x < g.n; ++x)
+            map[y][x] = '0' + g.range(0, 8);
+    const uint64_t ridges = (g.n + g.d) / 6 + 1;
+    for (uint64_t r = 0; r < ridges; ++r) {
+        const bool row = g.chance(0.5);
+        const uint64_t at = g.below(row ? g.d : g.n), len = row ? g.n : g.d;
+        for (uint64_t i = 0; i < len; ++i)
+            if (!g.chance(0.05))
+                (row ? map[at][i] : map[i][at]) = '9';
+    }
+    // smooth the insides so that each basin has a few low points only
+    for (int pass = 0; pass < 2; ++pass)
+        for (uint64_t y = 0; y < g.d; ++y)
+            for (uint64_t x = 0; x < g.n; ++x) {
+                char& c = map[y][x];
+                if (c == '9')
+                    continue;
+                int sum = 0, count = 0;
+                static const int8_t NEIGHBOURS[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+                for (const int8_t* d : NEIGHBOURS) {
+                    const int64_t nx = x + d[0], ny = y + d[1];
+                    if (nx >= 0 && ny >= 0 && nx < (int64_t)g.n && ny < (int64_t)g.d && map[ny][nx] != '9')
+                        sum += map[ny][nx] - '0', ++count;
+                }
+                if (count)
+                    c = '0' + (sum + c - '0' + count) / (count + 1);
+            }
+    if (g.header)
+        g.print("#include <stdint.h>\n\nconstexpr %s dimx = %llu;\nconstexpr %s dimy = %llu;\n\n", fit("int8_t", g.n),
+                (unsigned long long)g.n, fit("int8_t", g.d), (unsigned long long)g.d);
+    g.lines(map, "const char* const heightmap[]");
+}
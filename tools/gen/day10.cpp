@@ -0,0 +1,36 @@
+// Day 10: syntax scoring, -n chunk lines of about -d characters, a third corrupted, the rest incomplete
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n lines", 100, 100);
+    g.check(g.d >= 4, "-d must be at least 4");
+    static const char open[] = "([{<", close[] = ")]}>";
+    std::vector<std::string> lines;
+    for (uint64_t i = 0; i < g.n; ++i) {
+        const uint64_t len = g.range(g.d / 2, g.d);
+        std::string line, stack;
+        while (line.size() < len || stack.empty()) {
+            // chunks nest at most 12 deep, so that the completion scores fit 64 bits
+            if (stack.empty() || (stack.size() < 12 && g.chance(stack.size() < 6 ? 0.7 : 0.4))) {
+                const uint8_t k = g.below(4);
+                line += open[k];
+                stack += close[k];
+            } else {
+                line += stack.back();
+                stack.pop_back();
+            }
+        }
+        if (g.chance(1.0 / 3)) {
+            // corrupt it: close a chunk with the wrong character
+            const char wrong[] = {close[0], close[1], close[2], close[3]};
+            char c;
+            while ((c = wrong[g.below(4)]) == stack.back())
+                ;
+            line += c;
+        }
+        lines.push_back(line);
+    }
+    if (g.header)
+        g.print("#include <stdint.h>\n\nconstexpr %s n_lines = %llu;\n", fit("int8_t", g.n), (unsigned long long)g.n);
+    g.lines(lines, "const char* const lines[]");
+}
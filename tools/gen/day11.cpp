@@ -0,0 +1,58 @@
+// Day 11: dumbo octopus, a -n x -n grid of energy levels that all flash at once within MAX_STEPS
+#include "gen.h"
+
+constexpr uint64_t MAX_STEPS = 1000;
+
+// The first step at which all octopi flash, 0 if none up to MAX_STEPS
+static uint64_t synchronized(std::vector<std::string> grid) {
+    const int64_t n = grid.size();
+    std::vector<std::pair<int64_t, int64_t>> flashing;
+    for (uint64_t step = 1; step <= MAX_STEPS; ++step) {
+        for (int64_t y = 0; y < n; ++y)
+            for (int64_t x = 0; x < n; ++x)
+                if (++grid[y][x] == '9' + 1)
+                    flashing.push_back({y, x});
+        uint64_t flashes = 0;
+        while (!flashing.empty()) {
+            const auto [y, x] = flashing.back();
+            flashing.pop_back();
+            ++flashes;
+            for (int64_t yy = y - 1; yy <= y + 1; ++yy)
+                for (int64_t xx = x - 1; xx <= x + 1; ++xx)
+                    if (yy >= 0 && yy < n && xx >= 0 && xx < n && grid[yy][xx] <= '9' && ++grid[yy][xx] == '9' + 1)
+                        flashing.push_back({yy, xx});
+        }
+        for (std::string& row : grid)
+            for (char& c : row)
+                if (c > '9')
+                    c = '0';
+        if (flashes == (uint64_t)(n * n))
+            return step;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n dim", 10);
+    g.check(g.n >= 1, "-n must be at least 1");
+    // Random grids synchronize about half of the time at 10x10 and hardly ever beyond 20x20, so
+    // after a few of those (small grids only) the candidates are a common level with a shrinking
+    // share of random ones (a quarter, an eighth, ...), down to none: a uniform grid synchronizes
+    // when it first flashes.
+    std::vector<std::string> grid(g.n, std::string(g.n, '0'));
+    for (uint8_t attempt = g.n <= 20 ? 0 : 8;; ++attempt) {
+        const double noise = attempt < 8 ? 1.0 : attempt < 20 ? 0.25 / (1 << ((attempt - 8) / 2)) : 0.0;
+        const char level = '0' + g.below(10);
+        for (std::string& row : grid)
+            for (char& c : row)
+                c = g.chance(noise) ? '0' + g.below(10) : level;
+        if (synchronized(grid))
+            break;
+    }
+    if (g.header) {
+        const char* const type = fit("int8_t", g.n * g.n);
+        g.print("#include <stdint.h>\n\nconstexpr %s dimx = %llu;\nconstexpr %s dimy = %llu;\nconstexpr %s n_octopi = dimx*dimy;\n\n",
+                type, (unsigned long long)g.n, type, (unsigned long long)g.n, type);
+    }
+    g.lines(grid, "char energy[dimy][dimx + 1]");
+}
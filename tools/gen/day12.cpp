@@ -0,0 +1,65 @@
+// Day 12: passage pathing, -n small and -d big caves, big caves never connect to each other
+// (the paths would be endless), start and end connect to a few caves
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n small caves", 8, 3);
+    g.check(g.n >= 1 && g.d <= 26 && g.n + g.d + 2 <= 16, "at most 14 caves besides start and end (MAX_CAVES is 16)");
+    std::vector<std::string> small, big;
+    while (small.size() < g.n) {
+        std::string name = {(char)('a' + g.below(26)), (char)('a' + g.below(26))};
+        bool taken = name == "st" || name == "en";
+        for (const std::string& s : small)
+            taken |= s == name;
+        if (!taken)
+            small.push_back(name);
+    }
+    while (big.size() < g.d) {
+        std::string name = {(char)('A' + g.below(26)), (char)('A' + g.below(26))};
+        bool taken = false;
+        for (const std::string& b : big)
+            taken |= b == name;
+        if (!taken)
+            big.push_back(name);
+    }
+    std::vector<std::string> caves = small;
+    caves.insert(caves.end(), big.begin(), big.end());
+    // caves 0 .. n-1 are small, the rest big
+    auto is_big = [&](const size_t c) { return c >= small.size(); };
+    std::vector<std::vector<bool>> linked(caves.size(), std::vector<bool>(caves.size()));
+    std::vector<std::string> lines;
+    auto link = [&](const size_t a, const size_t b) {
+        if (a == b || linked[a][b] || (is_big(a) && is_big(b)))
+            return;
+        linked[a][b] = linked[b][a] = true;
+        lines.push_back(g.chance(0.5) ? caves[a] + "-" + caves[b] : caves[b] + "-" + caves[a]);
+    };
+    // a random spanning tree (starting from a small cave) so that every cave is reachable
+    std::vector<size_t> order(caves.size());
+    for (size_t c = 0; c < caves.size(); ++c)
+        order[c] = c;
+    g.shuffle(order.data() + 1, order.size() - 1);
+    for (size_t i = 1; i < order.size(); ++i) {
+        size_t parent;
+        do
+            parent = order[g.below(i)];
+        while (is_big(order[i]) && is_big(parent));
+        link(order[i], parent);
+    }
+    // a few more: big caves to small ones, small ones among themselves
+    for (size_t a = 0; a < caves.size(); ++a)
+        for (size_t b = a + 1; b < caves.size(); ++b)
+            if (g.chance(is_big(b) ? 0.25 : 0.1))
+                link(a, b);
+    for (const char* const cave : {"start", "end"}) {
+        const uint64_t k = g.range(1, caves.size() < 3 ? caves.size() : 3);
+        std::vector<size_t> c = order;
+        g.shuffle(c.data(), c.size());
+        for (uint64_t i = 0; i < k; ++i)
+            lines.push_back(g.chance(0.5) ? std::string(cave) + "-" + caves[c[i]] : caves[c[i]] + "-" + cave);
+    }
+    g.shuffle(lines.data(), lines.size());
+    if (g.header)
+        g.print("#include <stdint.h>\n\nconstexpr %s n_connections = %zu;\n\n", fit("int8_t", lines.size()), lines.size());
+    g.lines(lines, "char* const connections[]", "(char*)");
+}
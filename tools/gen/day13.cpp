@@ -0,0 +1,55 @@
+// Day 13: transparent origami, -n dots that fold -d times into the 40 x 6 code area
+// The folds are generated backwards: each unfolding doubles the paper and mirrors some of the dots
+#include <set>
+#include <tuple>
+#include <utility>
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n dots", 800, 12);
+    g.check(g.d >= 1 && g.d <= 18, "-d must be 1..18 (the coordinates are int16_t)");
+    // the folds in the order of the puzzle, alternating and starting along x, as in the real inputs
+    std::vector<std::pair<char, uint32_t>> folds(g.d);
+    uint32_t w = 40, h = 6;
+    for (uint64_t k = g.d; k-- > 0;) {
+        if (k % 2 == 0)
+            folds[k] = {'x', w}, w = 2 * w + 1;
+        else
+            folds[k] = {'y', h}, h = 2 * h + 1;
+    }
+    g.check(g.n >= 1 && g.n <= (uint64_t)w * h / 8, "-n is too large for the paper, add folds with -d");
+    // the code: about 40% of the area lit, like eight capital letters
+    std::vector<std::pair<uint32_t, uint32_t>> code;
+    for (uint32_t y = 0; y < 6; ++y)
+        for (uint32_t x = 0; x < 40; ++x)
+            if (g.chance(0.4))
+                code.push_back({x, y});
+    std::set<std::pair<uint32_t, uint32_t>> dots;
+    while (dots.size() < g.n) {
+        uint32_t x, y;
+        std::tie(x, y) = code[g.below(code.size())];
+        for (uint64_t k = g.d; k-- > 0;) {
+            if (!g.chance(0.5))
+                continue;
+            if (folds[k].first == 'x')
+                x = 2 * folds[k].second - x;
+            else
+                y = 2 * folds[k].second - y;
+        }
+        dots.insert({x, y});
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> shuffled(dots.begin(), dots.end());
+    g.shuffle(shuffled.data(), shuffled.size());
+    if (g.header)
+        g.print("#include <stdint.h>\n\nconst int16_t dots[%zu][2] = {\n", shuffled.size());
+    for (size_t i = 0; i < shuffled.size(); ++i)
+        g.print(g.header ? "{%u,%u}%s\n" : "%u,%u\n", shuffled[i].first, shuffled[i].second,
+                i + 1 < shuffled.size() ? "," : "};");
+    g.print(g.header ? "\nconst char* folds[] =\n{" : "\n");
+    for (size_t k = 0; k < folds.size(); ++k)
+        g.print(g.header ? "\"fold along %c=%u\"%s\n" : "fold along %c=%u\n", folds[k].first, folds[k].second,
+                k + 1 < folds.size() ? "," : "};");
+    if (g.header)
+        g.print("\nconstexpr %s n_dots = sizeof(dots)/sizeof(dots[0]);\nconstexpr int8_t n_folds = %llu;\n",
+                fit("int16_t", g.n), (unsigned long long)g.d);
+}
@@ -0,0 +1,30 @@
+// Day 14: extended polymerization, a template of -n elements out of -d, with a rule for every pair
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n template length", 20, 10);
+    g.check(g.n >= 2 && g.d >= 2 && g.d <= 26, "-n must be at least 2, -d 2..26");
+    char elements[26];
+    for (uint8_t i = 0; i < 26; ++i)
+        elements[i] = 'A' + i;
+    g.shuffle(elements, 26);
+    std::string polymer;
+    for (uint64_t i = 0; i < g.n; ++i)
+        polymer += elements[g.below(g.d)];
+    std::vector<std::string> rules;
+    for (uint64_t a = 0; a < g.d; ++a)
+        for (uint64_t b = 0; b < g.d; ++b)
+            rules.push_back(std::string{elements[a], elements[b]} + elements[g.below(g.d)]);
+    g.shuffle(rules.data(), rules.size());
+    if (!g.header) {
+        g.print("%s\n\n", polymer.c_str());
+        for (const std::string& r : rules)
+            g.print("%c%c -> %c\n", r[0], r[1], r[2]);
+        return 0;
+    }
+    g.print("#include <stdint.h>\n\nconst char* const polymer_template = \"%s\";\n\nconst char* rules[][2] = {\n",
+            polymer.c_str());
+    for (size_t i = 0; i < rules.size(); ++i)
+        g.print("{\"%c%c\", \"%c\"}%s\n", rules[i][0], rules[i][1], rules[i][2], i + 1 < rules.size() ? "," : "};");
+    g.print("\nconstexpr %s n_rules = sizeof(rules)/sizeof(rules[0]);\n", fit("int8_t", rules.size()));
+}
@@ -0,0 +1,16 @@
+// Day 15: chiton, a -n x -n risk level map
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n dim", 100);
+    g.check(g.n >= 2, "-n must be at least 2");
+    if (g.header)
+        g.print("#include <stdint.h>\n\nconstexpr %s base_dim = %llu;\nconst int8_t risk[base_dim][base_dim] = {\n",
+                fit("int8_t", g.n), (unsigned long long)g.n);
+    for (uint64_t y = 0; y < g.n; ++y) {
+        g.print(g.header ? "{" : "");
+        for (uint64_t x = 0; x < g.n; ++x)
+            g.print(g.header && x ? ",%u" : "%u", (unsigned)g.range(1, 9));
+        g.print(!g.header ? "\n" : y + 1 < g.n ? "},\n" : "}};\n");
+    }
+}
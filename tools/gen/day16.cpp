@@ -0,0 +1,98 @@
+// Day 16: packet decoder, one transmission of -n packets, a random tree of operators and literals
+// whose value stays within 48 bits
+#include "gen.h"
+
+struct Packet {
+    std::string bits;
+    uint64_t value;
+};
+
+static void append(std::string& bits, const uint64_t v, const uint8_t width) {
+    for (int8_t b = width - 1; b >= 0; --b)
+        bits += v >> b & 1 ? '1' : '0';
+}
+
+static Packet literal(Gen& g) {
+    Packet p;
+    p.value = g.chance(0.8) ? g.below(256) : g.below(1ull << 32);
+    append(p.bits, g.below(8), 3);
+    append(p.bits, 4, 3);
+    uint8_t groups = 1;
+    while (groups < 16 && p.value >> 4 * groups)
+        ++groups;
+    for (uint8_t i = groups; i-- > 0;) {
+        p.bits += i ? '1' : '0';
+        append(p.bits, p.value >> 4 * i, 4);
+    }
+    return p;
+}
+
+// a packet of count packets (itself included)
+static Packet packet(Gen& g, const uint64_t count) {
+    if (count == 1)
+        return literal(g);
+    // the comparisons need exactly two sub-packets
+    const bool compare = count >= 3 && g.chance(0.3);
+    const uint64_t n_sub = compare ? 2 : g.range(1, count - 1 < 8 ? count - 1 : 8);
+    std::vector<uint64_t> sizes(n_sub, 1);
+    for (uint64_t rest = count - 1 - n_sub; rest > 0; --rest)
+        ++sizes[g.below(n_sub)];
+    std::vector<Packet> subs;
+    for (const uint64_t s : sizes)
+        subs.push_back(packet(g, s));
+
+    uint8_t type;
+    uint64_t value;
+    if (compare) {
+        type = g.range(5, 7);
+        value = type == 5 ? subs[0].value > subs[1].value : type == 6 ? subs[0].value < subs[1].value
+                                                                       : subs[0].value == subs[1].value;
+    } else {
+        type = g.below(4);
+        uint64_t sum = 0, product = 1, lo = UINT64_MAX, hi = 0;
+        bool small = true;
+        for (const Packet& s : subs) {
+            sum += s.value;
+            if (s.value && product > (1ull << 48) / s.value)
+                small = false;
+            product *= s.value;
+            lo = s.value < lo ? s.value : lo;
+            hi = s.value > hi ? s.value : hi;
+        }
+        // products and sums that would outgrow 48 bits become a minimum
+        if (type == 1 && !small)
+            type = 2;
+        if (type == 0 && sum >> 48)
+            type = 2;
+        value = type == 0 ? sum : type == 1 ? product : type == 2 ? lo : hi;
+    }
+
+    Packet p;
+    p.value = value;
+    append(p.bits, g.below(8), 3);
+    append(p.bits, type, 3);
+    std::string body;
+    for (const Packet& s : subs)
+        body += s.bits;
+    if (body.size() < (1u << 15) && g.chance(0.5)) {
+        p.bits += '0';
+        append(p.bits, body.size(), 15);
+    } else {
+        p.bits += '1';
+        append(p.bits, n_sub, 11);
+    }
+    p.bits += body;
+    return p;
+}
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n packets", 300);
+    g.check(g.n >= 1, "-n must be at least 1");
+    std::string bits = packet(g, g.n).bits;
+    while (bits.size() % 4)
+        bits += '0';
+    std::string hex;
+    for (size_t i = 0; i < bits.size(); i += 4)
+        hex += "0123456789ABCDEF"[std::stoi(bits.substr(i, 4), nullptr, 2)];
+    g.lines({hex}, "const char* const input[]");
+}
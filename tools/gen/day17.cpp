@@ -0,0 +1,21 @@
+// Day 17: trick shot, a target area about -n deep below the probe, some x velocity stalls above it
+#include <math.h>
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n depth", 100);
+    g.check(g.n >= 4 && g.n <= 10000, "-n must be 4..10000");
+    const int64_t y1 = -(int64_t)g.n - g.range(0, g.n / 2);
+    const int64_t y2 = y1 + g.range(g.n / 4, g.n / 2);
+    // a triangular number k(k+1)/2 inside x1..x2: the probe can stop right above the target
+    const int64_t k0 = (int64_t)sqrt(2.0 * g.n) + 1;
+    const int64_t k = g.range(k0, k0 + k0 / 2 + 1);
+    const int64_t stop = k * (k + 1) / 2;
+    const int64_t x1 = stop - g.range(0, k);
+    const int64_t x2 = stop + g.range(k / 2, 2 * k);
+    if (g.header)
+        g.print("#include <stdint.h>\n\nstatic const int16_t target[2][2] = {{%lld, %lld}, {%lld, %lld}};\n",
+                (long long)x1, (long long)x2, (long long)y1, (long long)y2);
+    else
+        g.print("target area: x=%lld..%lld, y=%lld..%lld\n", (long long)x1, (long long)x2, (long long)y1, (long long)y2);
+}
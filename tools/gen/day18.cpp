@@ -0,0 +1,19 @@
+// Day 18: snailfish, -n reduced snailfish numbers (pairs nested at most 4 deep, regular numbers 0..9)
+#include "gen.h"
+
+static std::string number(Gen& g, const uint8_t depth) {
+    if (depth > 4 || (depth > 1 && g.chance(0.3)))
+        return std::to_string(g.below(10));
+    return "[" + number(g, depth + 1) + "," + number(g, depth + 1) + "]";
+}
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n numbers", 100);
+    g.check(g.n >= 2, "-n must be at least 2");
+    std::vector<std::string> lines;
+    for (uint64_t i = 0; i < g.n; ++i)
+        lines.push_back(number(g, 1));
+    if (g.header)
+        g.print("#include <stdint.h>\n\nconstexpr %s n_input = %llu;\n", fit("int8_t", g.n), (unsigned long long)g.n);
+    g.lines(lines, "const char* input[]", "    ", "\n};");
+}
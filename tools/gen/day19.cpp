@@ -0,0 +1,134 @@
+// Day 19: beacon scanner, -n scanners in a random tree, each sharing 12 beacons with its parent
+// and seeing about 26, in one of the 24 orientations (scanner 0 in the identity)
+#include "gen.h"
+
+struct P {
+    int32_t x, y, z;
+    bool operator==(const P& o) const { return x == o.x && y == o.y && z == o.z; }
+};
+
+static bool sees(const P& scanner, const P& b) {
+    return abs(b.x - scanner.x) <= 1000 && abs(b.y - scanner.y) <= 1000 && abs(b.z - scanner.z) <= 1000;
+}
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n scanners", 30);
+    g.check(g.n >= 1 && g.n <= 255, "-n must be 1..255");
+    // the 24 rotations: signed permutations of the axes with determinant 1
+    std::vector<int8_t> rotations;
+    static const uint8_t PERMS[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    static const bool ODD[6] = {false, true, true, false, false, true};
+    for (uint8_t p = 0; p < 6; ++p)
+        for (uint8_t s = 0; s < 8; ++s)
+            if (ODD[p] == (__builtin_popcount(s) % 2 == 1))
+                rotations.push_back(8 * p + s);
+
+    std::vector<P> scanners = {{0, 0, 0}}, beacons;
+    auto taken = [&](const P& p) {
+        for (const P& s : scanners)
+            if (s == p)
+                return true;
+        for (const P& b : beacons)
+            if (b == p)
+                return true;
+        return false;
+    };
+    // a new beacon seen by scanner a (and b) but by no other, false if there is no room for one
+    auto add = [&](const P& a, const P& b) {
+        for (uint16_t tries = 0; tries < 2000; ++tries) {
+            const P p = {(int32_t)g.range(-1000, 1000) + a.x, (int32_t)g.range(-1000, 1000) + a.y,
+                         (int32_t)g.range(-1000, 1000) + a.z};
+            if (!sees(b, p) || taken(p))
+                continue;
+            bool other = false;
+            for (const P& s : scanners)
+                other |= !(s == a) && !(s == b) && sees(s, p);
+            if (!other) {
+                beacons.push_back(p);
+                return true;
+            }
+        }
+        return false;
+    };
+    auto visible = [&](const P& s, const P& o) {
+        int count = 0;
+        for (const P& b : beacons)
+            count += sees(s, b) && sees(o, b);
+        return count;
+    };
+    for (uint64_t i = 0; i < 26; ++i)
+        add(scanners[0], scanners[0]);
+    while (scanners.size() < g.n) {
+        // a new scanner 600..1000 away from its parent along one axis, not too close to another and
+        // sharing 10 to 12 of the parent's beacons already: the day only matches scanners sharing
+        // exactly 12, and more than about 26 beacons per scanner make its distance hashes collide
+        P parent, s;
+        bool crowded;
+        do {
+            parent = scanners[g.below(scanners.size())];
+            int32_t d[3];
+            for (int32_t& c : d)
+                c = g.range(-400, 400);
+            const uint8_t axis = g.below(3);
+            d[axis] = (g.chance(0.5) ? 1 : -1) * g.range(600, 1000);
+            s = {parent.x + d[0], parent.y + d[1], parent.z + d[2]};
+            const int shared = visible(s, parent);
+            crowded = taken(s) || shared < 10 || shared > 12 || visible(s, s) > 16;
+            for (const P& o : scanners)
+                crowded |= abs(o.x - s.x) < 500 && abs(o.y - s.y) < 500 && abs(o.z - s.z) < 500;
+        } while (crowded);
+        const size_t n_before = beacons.size();
+        scanners.push_back(s);
+        bool room = true;
+        while (room && visible(s, parent) < 12)
+            room = add(s, parent);
+        while (room && visible(s, s) < 26)
+            room = add(s, s);
+        if (!room) {
+            // crowded after all, place it elsewhere
+            scanners.pop_back();
+            beacons.resize(n_before);
+        }
+    }
+
+    // what each scanner sees, relative to it and rotated
+    std::vector<std::vector<P>> seen(scanners.size());
+    size_t n_beacons = 0;
+    for (size_t i = 0; i < scanners.size(); ++i) {
+        const uint8_t r = i ? rotations[g.below(24)] : 0;
+        for (const P& b : beacons) {
+            if (!sees(scanners[i], b))
+                continue;
+            const int32_t v[3] = {b.x - scanners[i].x, b.y - scanners[i].y, b.z - scanners[i].z};
+            P p = {v[PERMS[r / 8][0]], v[PERMS[r / 8][1]], v[PERMS[r / 8][2]]};
+            p.x *= r & 1 ? -1 : 1;
+            p.y *= r & 2 ? -1 : 1;
+            p.z *= r & 4 ? -1 : 1;
+            seen[i].push_back(p);
+        }
+        g.shuffle(seen[i].data(), seen[i].size());
+        n_beacons = seen[i].size() > n_beacons ? seen[i].size() : n_beacons;
+    }
+    g.check(n_beacons < 255, "a scanner sees too many beacons, try another seed");
+
+    if (!g.header) {
+        for (size_t i = 0; i < seen.size(); ++i) {
+            g.print("%s--- scanner %zu ---\n", i ? "\n" : "", i);
+            for (const P& p : seen[i])
+                g.print("%d,%d,%d\n", p.x, p.y, p.z);
+        }
+        return 0;
+    }
+    // one more beacon than the most a scanner sees: a {0,0,0} ends each list
+    ++n_beacons;
+    g.print("#include <stdint.h>\n#include \"point.h\"\n\nconstexpr %s n_scanners = %zu;\nconstexpr %s n_beacons = %zu;\n",
+            fit("int8_t", seen.size()), seen.size(), fit("int8_t", n_beacons), n_beacons);
+    g.print("constexpr %s n_beacon_pairs = (n_beacons-1)*n_beacons/2;\n\n", fit("int16_t", n_beacons * (n_beacons - 1) / 2));
+    g.print("uint8_t beacons_per_scanner[n_scanners];\nPoint scanners[n_scanners][n_beacons] = {\n");
+    for (size_t i = 0; i < seen.size(); ++i) {
+        g.print(i ? ",\n{" : "{");
+        for (size_t j = 0; j < seen[i].size(); ++j)
+            g.print("{%d,%d,%d}%s", seen[i][j].x, seen[i][j].y, seen[i][j].z, j + 1 < seen[i].size() ? ",\n" : "}\n");
+    }
+    g.print("};\n");
+}
@@ -0,0 +1,25 @@
+// Day 20: trench map, a -n x -n image and an algorithm that lights the infinite dark background
+// on odd steps (the trap of the real inputs)
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n image dim", 100);
+    g.check(g.n >= 1 && g.n <= 255, "-n must be 1..255");
+    char algo[513] = {};
+    for (uint16_t i = 0; i < 512; ++i)
+        algo[i] = g.chance(0.5) ? '#' : '.';
+    algo[0] = '#';
+    algo[511] = '.';
+    std::vector<std::string> image(g.n, std::string(g.n, '.'));
+    for (std::string& row : image)
+        for (char& c : row)
+            c = g.chance(0.5) ? '#' : '.';
+    if (!g.header) {
+        g.print("%s\n\n", algo);
+        g.lines(image, nullptr);
+        return 0;
+    }
+    g.print("#include <stdint.h>\n\nconst char input_algo[] = \"%s\";\n\n", algo);
+    g.lines(image, "const char* const input_map[]", "", "\n};");
+    g.print("\nconstexpr uint8_t input_dim = sizeof(input_map) / sizeof(input_map[0]);\n");
+}
@@ -0,0 +1,11 @@
+// Day 21: Dirac dice, random starting positions
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "", 0);
+    const unsigned p1 = g.range(1, 10), p2 = g.range(1, 10);
+    if (g.header)
+        g.print("#include <stdint.h>\n\nuint8_t position[2] = {%u, %u};\n", p1, p2);
+    else
+        g.print("Player 1 starting position: %u\nPlayer 2 starting position: %u\n", p1, p2);
+}
@@ -0,0 +1,34 @@
+// Day 22: reactor reboot, -n steps: 20 in the initialization region (-50..50), the rest large
+// cuboids of up to 100000 in every direction
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n steps", 420);
+    g.check(g.n >= 1, "-n must be at least 1");
+    std::vector<std::string> steps;
+    char line[96];
+    for (uint64_t i = 0; i < g.n; ++i) {
+        const bool init = i < 20;
+        const int64_t extent = init ? 50 : 100000;
+        int64_t lo[3], hi[3];
+        bool inside;
+        do {
+            inside = true;
+            for (uint8_t a = 0; a < 3; ++a) {
+                const int64_t size = init ? g.range(10, 50) : g.range(5000, 40000);
+                lo[a] = g.range(-extent, extent - size);
+                hi[a] = lo[a] + size;
+                inside &= lo[a] <= 50 && hi[a] >= -50;
+            }
+            // the large ones stay clear of the initialization region like in the puzzle
+        } while (!init && inside);
+        // the first one is on, the last initialization steps switch some off, as in the puzzle
+        const bool on = i == 0 || (init ? i < 10 || g.chance(0.5) : g.chance(0.7));
+        snprintf(line, sizeof(line), "%s x=%lld..%lld,y=%lld..%lld,z=%lld..%lld", on ? "on" : "off", (long long)lo[0],
+                 (long long)hi[0], (long long)lo[1], (long long)hi[1], (long long)lo[2], (long long)hi[2]);
+        steps.push_back(line);
+    }
+    if (g.header)
+        g.print("#include <stdint.h>\n\nconstexpr %s nsteps = %llu;\n\n", fit("uint16_t", g.n), (unsigned long long)g.n);
+    g.lines(steps, "const char* const steps[nsteps]", "    ", "\n};");
+}
@@ -0,0 +1,27 @@
+// Day 23: amphipod, side rooms -d deep holding a shuffled, unsolved burrow
+// (the day reads the first two rows, part 2 inserts the two folded rows of the puzzle)
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "", 0, 2);
+    g.check(g.d >= 2 && g.d <= 8, "-d must be 2..8");
+    std::string pods;
+    for (uint8_t k = 0; k < 4; ++k)
+        pods += std::string(g.d, 'A' + k);
+    bool solved;
+    do {
+        g.shuffle(&pods[0], pods.size());
+        solved = true;
+        for (size_t i = 0; i < pods.size(); ++i)
+            solved &= pods[i] == 'A' + i % 4;
+    } while (solved);
+    std::vector<std::string> lines = {"#############", "#...........#"};
+    for (uint64_t row = 0; row < g.d; ++row) {
+        std::string l = row ? "  #" : "###";
+        for (uint8_t k = 0; k < 4; ++k)
+            l += std::string(1, pods[4 * row + k]) + "#";
+        lines.push_back(row ? l : l + "##");
+    }
+    lines.push_back("  #########");
+    g.lines(lines, "const char* input[]", "    ", "\n};");
+}
@@ -0,0 +1,42 @@
+// Day 24: arithmetic logic unit, a MONAD program of 14 blocks: 7 push a digit on the base 26
+// stack in z, 7 pop one and compare, paired so that valid model numbers exist
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "", 0);
+    // a random balanced sequence of pushes and pops
+    bool push[14];
+    for (uint8_t i = 0, depth = 0, pushes = 0; i < 14; ++i) {
+        push[i] = depth == 0 || (pushes < 7 && g.chance(0.5));
+        pushes += push[i];
+        depth += push[i] ? 1 : -1;
+    }
+    int32_t div[14], check[14], offset[14];
+    uint8_t stack[7], sp = 0;
+    for (uint8_t i = 0; i < 14; ++i) {
+        offset[i] = g.range(1, 16);
+        if (push[i]) {
+            div[i] = 1;
+            check[i] = g.range(10, 16);
+            stack[sp++] = i;
+        } else {
+            // digit i = digit j + offset j + check i, within -8..8 of it
+            const uint8_t j = stack[--sp];
+            div[i] = 26;
+            check[i] = g.range(-8, offset[j] < 8 ? offset[j] : 8) - offset[j];
+        }
+    }
+    std::vector<std::string> program;
+    for (uint8_t i = 0; i < 14; ++i) {
+        const std::string lines[18] = {"inp w", "mul x 0", "add x z", "mod x 26", "div z " + std::to_string(div[i]),
+                                       "add x " + std::to_string(check[i]), "eql x w", "eql x 0", "mul y 0", "add y 25",
+                                       "mul y x", "add y 1", "mul z y", "mul y 0", "add y w",
+                                       "add y " + std::to_string(offset[i]), "mul y x", "add z y"};
+        program.insert(program.end(), lines, lines + 18);
+    }
+    if (g.header)
+        g.print("#include <stdint.h>\n\n");
+    g.lines(program, "const char* const program[]", "", "\n};");
+    if (g.header)
+        g.print("\nconstexpr uint8_t n_lines = sizeof(program) / sizeof(program[0]);\n");
+}
@@ -0,0 +1,17 @@
+// Day 25: sea cucumber, a -n x -d herd
+#include "gen.h"
+
+int main(int argc, char** argv) {
+    Gen g(argc, argv, "-n width", 139, 137);
+    g.check(g.n >= 1 && g.d >= 1, "-n and -d must be at least 1");
+    std::vector<std::string> herd(g.d, std::string(g.n, '.'));
+    for (std::string& row : herd)
+        for (char& c : row) {
+            const uint64_t r = g.below(10);
+            c = r < 3 ? '>' : r < 6 ? 'v' : '.';
+        }
+    if (g.header)
+        g.print("#include <stdint.h>\n\nconstexpr %s dimx = %llu;\nconstexpr %s dimy = %llu;\n", fit("uint8_t", g.n),
+                (unsigned long long)g.n, fit("uint8_t", g.d), (unsigned long long)g.d);
+    g.lines(herd, "char input[dimy][dimx + 1]", "", "\n};");
+}
@@ -0,0 +1,138 @@
+#ifndef __GEN_H__
+#define __GEN_H__
+
+// Shared part of the input generators (tools/gen/dayNN.cpp, built as dayNN_gen).
+// Each generator writes a valid puzzle input at a chosen scale and seed, either as a raw
+// input file (as downloaded from the AoC site, read by the host builds through AOC64_INPUT,
+// see lib/input_file.h) or as an input.h header in the layout of the day's input.example.h:
+//
+//     build/day15_gen -n 2000 -s 7 -f header -o 2021/day15/input.h
+//     build/day01_gen -n 1000000 > depths.txt && AOC64_INPUT=depths.txt build/day01_host
+//
+// Options: -n the scale, -d a second dimension (what they mean is in the usage line of each day),
+// -s the seed, -f raw|header (default raw) and -o the output file (default stdout).
+// The same seed gives the same input on every platform (splitmix64, no libc rand()).
+// Counts that outgrow the integer type of the example header get the next wider type.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+struct Gen {
+    uint64_t n;      // scale (-n)
+    uint64_t d;      // second dimension (-d)
+    uint64_t seed;   // -s
+    bool header;     // -f header
+    FILE* out;       // -o
+    uint64_t state;
+
+    // usage: what -n and -d mean for this day, e.g. "-n depths", empty if the day has no scale
+    Gen(int argc, char** argv, const char* const usage, const uint64_t default_n, const uint64_t default_d = 0)
+        : n(default_n), d(default_d), seed(1), header(false), out(stdout) {
+        const char* path = nullptr;
+        for (int i = 1; i < argc; ++i) {
+            if (i + 1 < argc && strcmp(argv[i], "-n") == 0) {
+                n = strtoull(argv[++i], nullptr, 0);
+            } else if (i + 1 < argc && strcmp(argv[i], "-d") == 0) {
+                d = strtoull(argv[++i], nullptr, 0);
+            } else if (i + 1 < argc && strcmp(argv[i], "-s") == 0) {
+                seed = strtoull(argv[++i], nullptr, 0);
+            } else if (i + 1 < argc && strcmp(argv[i], "-f") == 0 && strcmp(argv[i + 1], "raw") == 0) {
+                header = false, ++i;
+            } else if (i + 1 < argc && strcmp(argv[i], "-f") == 0 && strcmp(argv[i + 1], "header") == 0) {
+                header = true, ++i;
+            } else if (i + 1 < argc && strcmp(argv[i], "-o") == 0) {
+                path = argv[++i];
+            } else {
+                fprintf(stderr, "usage: %s", argv[0]);
+                if (*usage)
+                    fprintf(stderr, " [%s (default %llu)]", usage, (unsigned long long)default_n);
+                if (default_d)
+                    fprintf(stderr, " [-d (default %llu)]", (unsigned long long)default_d);
+                fprintf(stderr, " [-s seed] [-f raw|header] [-o file]\n");
+                exit(2);
+            }
+        }
+        state = seed;
+        if (path != nullptr && (out = fopen(path, "w")) == nullptr) {
+            perror(path);
+            exit(1);
+        }
+    }
+    ~Gen() {
+        if (out != stdout)
+            fclose(out);
+    }
+
+    // fails with a message when an option is out of the range the puzzle allows
+    void check(const bool ok, const char* const message) const {
+        if (!ok) {
+            fprintf(stderr, "%s\n", message);
+            exit(2);
+        }
+    }
+
+    // random numbers (splitmix64)
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    // uniform in 0 .. m-1
+    uint64_t below(const uint64_t m) { return next() % m; }
+    // uniform in lo .. hi
+    int64_t range(const int64_t lo, const int64_t hi) { return lo + (int64_t)below(hi - lo + 1); }
+    // true with probability p
+    bool chance(const double p) { return (next() >> 11) * (1.0 / 9007199254740992.0) < p; }
+    template <typename T>
+    void shuffle(T* const a, const size_t count) {
+        for (size_t i = count; i > 1; --i) {
+            const size_t j = below(i);
+            const T t = a[i - 1];
+            a[i - 1] = a[j];
+            a[j] = t;
+        }
+    }
+
+    void print(const char* const fmt, ...) __attribute__((format(printf, 2, 3)));
+
+    // The raw input as lines: written as they are, or in a header as the string array
+    // decl (e.g. "const char* input[]") with one string per line, each prefixed by prefix,
+    // and close after the last one ("\n};" for a brace on its own line)
+    void lines(const std::vector<std::string>& lines, const char* const decl, const char* const prefix = "",
+               const char* const close = "};") {
+        if (!header) {
+            for (const std::string& l : lines)
+                fprintf(out, "%s\n", l.c_str());
+            return;
+        }
+        fprintf(out, "%s = {\n", decl);
+        for (size_t i = 0; i < lines.size(); ++i)
+            fprintf(out, "%s\"%s\"%s\n", prefix, lines[i].c_str(), i + 1 < lines.size() ? "," : close);
+    }
+};
+
+#include <stdarg.h>
+void Gen::print(const char* const fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(out, fmt, args);
+    va_end(args);
+}
+
+// The integer type of a count in a header: type as in the example header if max fits, else a wider one
+static const char* fit(const char* const type, const uint64_t max) {
+    const bool is_signed = type[0] == 'i';
+    const int bits = atoi(type + (is_signed ? 3 : 4));
+    static const char* const types[2][4] = {{"uint8_t", "uint16_t", "uint32_t", "uint64_t"},
+                                            {"int8_t", "int16_t", "int32_t", "int64_t"}};
+    for (int b = 8, i = 0; b <= 64; b *= 2, ++i)
+        if (b >= bits && (b == 64 || max < (1ull << (b - is_signed))))
+            return types[is_signed][i];
+    return types[is_signed][3];
+}
+
+#endif // __GEN_H__
@@ -0,0 +1,309 @@
+// Replays an REU transfer trace (AOC64_REU_TRACE, see lib/reucpy.h) through cache and prefetch
+// models of a RAM-side REU cache and reports hit rates, DMA traffic and simulated cycles.
+//
+//     AOC64_REU_TRACE=day23.reutrace build/day23_host
+//     build/reu_replay day23.reutrace                         # the default models
+//     build/reu_replay day23.reutrace 4096/32/1 16384/64/4/wb+1
+//
+// A model is SIZE/LINE/WAYS, optionally followed by /wb (write-back, default write-through)
+// and +N (on a miss also fetch the next N lines in the same DMA transfer).
+//
+// Cost model (cycles, approximate for a PAL C64 with llvm-mos):
+// - every DMA transfer costs SETUP cycles to program the REU plus one cycle per byte,
+// - a cache hit costs LOOKUP cycles, the caller uses the cached line in place (like the
+//   single record cache of the REU containers).
+// Fills (reuset, memset_reu) and transfers larger than a quarter of the cache bypass it.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#define REU_TRACE_LOAD  0x01
+#define REU_TRACE_FIX_RAM 0x80
+#define REU_TRACE_FIX_REU 0x40
+#define REU_TRACE_VERSION 1
+
+static uint32_t SETUP = 40;   // cycles to program the REU registers and start a transfer
+static uint32_t LOOKUP = 25;  // cycles for a cache hit (tag compare, pointer into the line)
+
+struct Record {
+    uint8_t op;
+    uint32_t reu_addr;
+    uint16_t ram_addr;
+    uint32_t length;
+};
+
+struct Stats {
+    uint64_t hits, misses;   // in lines
+    uint64_t transfers;      // DMA transfers
+    uint64_t bytes;          // DMA bytes
+    uint64_t cycles;
+
+    void dma(const uint32_t length) { ++transfers; bytes += length; cycles += SETUP + length; }
+};
+
+struct Cache {
+    char name[48];
+    uint32_t size, line, ways, prefetch;
+    bool write_back;
+    uint32_t sets;
+    // per way of each set: tag (line number + 1, 0 if empty), last use and dirty flag
+    std::vector<uint32_t> tag;
+    std::vector<uint64_t> used;
+    std::vector<uint8_t> dirty;
+    uint64_t clock;
+    Stats stats;
+
+    bool parse(const char* spec);
+    void replay(const Record& r);
+    void flush();
+
+    // way holding line l, -1 if not cached
+    int32_t find(const uint32_t l) const {
+        const uint32_t base = (l % sets) * ways;
+        for (uint32_t w = 0; w < ways; ++w)
+            if (tag[base + w] == l + 1)
+                return base + w;
+        return -1;
+    }
+    void write_back_way(const uint32_t w) {
+        if (dirty[w]) {
+            stats.dma(line);
+            dirty[w] = 0;
+        }
+    }
+    // makes room for line l and returns its way (least recently used of the set)
+    uint32_t allocate(const uint32_t l) {
+        const uint32_t base = (l % sets) * ways;
+        uint32_t victim = base;
+        for (uint32_t w = base; w < base + ways; ++w) {
+            if (tag[w] == 0) {
+                victim = w;
+                break;
+            }
+            if (used[w] < used[victim])
+                victim = w;
+        }
+        write_back_way(victim);
+        tag[victim] = l + 1;
+        used[victim] = ++clock;
+        return victim;
+    }
+    // drops the lines of [first, last] (written around the cache), dirty lines are written back
+    // first unless the transfer overwrites them
+    void invalidate(const uint32_t first, const uint32_t last, const bool overwritten) {
+        for (uint32_t l = first; l <= last; ++l) {
+            const int32_t w = find(l);
+            if (w < 0)
+                continue;
+            if (overwritten)
+                dirty[w] = 0;
+            else
+                write_back_way(w);
+            tag[w] = 0;
+        }
+    }
+};
+
+bool Cache::parse(const char* spec) {
+    char policy[4] = "wt";
+    prefetch = 0;
+    int n = 0;
+    if (sscanf(spec, "%u/%u/%u%n", &size, &line, &ways, &n) != 3)
+        return false;
+    const char* rest = spec + n;
+    if (strncmp(rest, "/wb", 3) == 0) {
+        strcpy(policy, "wb");
+        rest += 3;
+    } else if (strncmp(rest, "/wt", 3) == 0) {
+        rest += 3;
+    }
+    if (*rest == '+' && sscanf(rest + 1, "%u", &prefetch) != 1)
+        return false;
+    else if (*rest != '+' && *rest != 0)
+        return false;
+    if (line == 0 || ways == 0 || size < line * ways || size % (line * ways))
+        return false;
+    write_back = policy[1] == 'b';
+    sets = size / (line * ways);
+    tag.assign(sets * ways, 0);
+    used.assign(sets * ways, 0);
+    dirty.assign(sets * ways, 0);
+    clock = 0;
+    memset(&stats, 0, sizeof(stats));
+    snprintf(name, sizeof(name), "%uK/%u/%u-way %s", size >> 10, line, ways, policy);
+    if (prefetch)
+        snprintf(name + strlen(name), sizeof(name) - strlen(name), " +%u", prefetch);
+    return true;
+}
+
+void Cache::replay(const Record& r) {
+    const uint32_t first = r.reu_addr / line;
+    const uint32_t last = (r.reu_addr + r.length - 1) / line;
+    const bool load = r.op & REU_TRACE_LOAD;
+
+    if ((r.op & (REU_TRACE_FIX_RAM | REU_TRACE_FIX_REU)) || r.length > size / 4) {
+        // bypass: the transfer goes straight to the REU
+        invalidate(first, last, !load);
+        stats.dma(r.length);
+        return;
+    }
+
+    if (!load && !write_back) {
+        // write-through, no allocate: cached lines are updated in place
+        for (uint32_t l = first; l <= last; ++l) {
+            const int32_t w = find(l);
+            if (w >= 0)
+                used[w] = ++clock;
+        }
+        stats.dma(r.length);
+        return;
+    }
+
+    uint32_t l = first;
+    while (l <= last) {
+        const int32_t w = find(l);
+        if (w >= 0) {
+            ++stats.hits;
+            stats.cycles += LOOKUP;
+            used[w] = ++clock;
+            if (!load)
+                dirty[w] = 1;
+            ++l;
+            continue;
+        }
+        // miss: fetch the run of missing lines of the transfer plus the prefetched ones in one DMA
+        // (a store covering a whole line doesn't need to fetch it)
+        uint32_t end = l;
+        while (end < last && find(end + 1) < 0)
+            ++end;
+        const uint32_t run_end = end;
+        for (uint32_t p = 0; p < prefetch && find(end + 1) < 0; ++p)
+            ++end;
+        const bool whole = !load && l * line >= r.reu_addr && (end + 1) * line <= r.reu_addr + r.length;
+        stats.misses += run_end - l + 1;
+        if (!whole)
+            stats.dma((end - l + 1) * line);
+        else
+            stats.cycles += LOOKUP;
+        for (uint32_t m = l; m <= end; ++m) {
+            const uint32_t way = allocate(m);
+            dirty[way] = !load && m <= run_end;
+        }
+        l = run_end + 1;
+    }
+}
+
+void Cache::flush() {
+    for (uint32_t w = 0; w < sets * ways; ++w)
+        write_back_way(w);
+}
+
+static const char* const DEFAULT_MODELS[] = {
+    "1024/16/1", "4096/32/1", "4096/32/4", "4096/32/4/wb", "16384/64/4", "16384/64/4/wb",
+    "16384/64/4/wb+1", "16384/256/2/wb",
+};
+
+static void usage() {
+    fprintf(stderr, "usage: reu_replay [--setup CYCLES] [--lookup CYCLES] TRACE [SIZE/LINE/WAYS[/wb][+N] ...]\n");
+    exit(2);
+}
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    std::vector<Cache> models;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--setup") == 0 && i + 1 < argc) {
+            SETUP = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--lookup") == 0 && i + 1 < argc) {
+            LOOKUP = atoi(argv[++i]);
+        } else if (argv[i][0] == '-') {
+            usage();
+        } else if (path == nullptr) {
+            path = argv[i];
+        } else {
+            models.emplace_back();
+            if (!models.back().parse(argv[i])) {
+                fprintf(stderr, "invalid model %s (SIZE must be a multiple of LINE*WAYS)\n", argv[i]);
+                return 2;
+            }
+        }
+    }
+    if (path == nullptr)
+        usage();
+    if (models.empty()) {
+        for (const char* spec : DEFAULT_MODELS) {
+            models.emplace_back();
+            models.back().parse(spec);
+        }
+    }
+
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr) {
+        perror(path);
+        return 1;
+    }
+    uint8_t header[8];
+    if (fread(header, 1, sizeof(header), f) != sizeof(header) || memcmp(header, "REUT", 4) != 0) {
+        fprintf(stderr, "%s: not an REU trace\n", path);
+        return 1;
+    }
+    if (header[4] != REU_TRACE_VERSION) {
+        fprintf(stderr, "%s: trace version %u, expected %u\n", path, header[4], REU_TRACE_VERSION);
+        return 1;
+    }
+
+    Stats none = {};
+    uint64_t loads = 0, stores = 0, fills = 0, load_bytes = 0, store_bytes = 0;
+    std::vector<uint8_t> pages(1 << 16); // 256 byte REU pages touched
+    uint8_t buffer[8 << 12];
+    size_t n;
+    while ((n = fread(buffer, 8, sizeof(buffer) / 8, f)) > 0) {
+        for (size_t i = 0; i < n; ++i) {
+            const uint8_t* b = buffer + 8 * i;
+            const uint16_t size = b[6] | b[7] << 8;
+            const Record r = { b[0], (uint32_t)(b[1] | b[2] << 8 | b[3] << 16), (uint16_t)(b[4] | b[5] << 8),
+                               size ? size : 0x10000u };
+            if (r.reu_addr + r.length > 0x1000000) {
+                fprintf(stderr, "%s: transfer beyond 16MB\n", path);
+                return 1;
+            }
+            if (r.op & (REU_TRACE_FIX_RAM | REU_TRACE_FIX_REU))
+                ++fills;
+            else if (r.op & REU_TRACE_LOAD)
+                ++loads, load_bytes += r.length;
+            else
+                ++stores, store_bytes += r.length;
+            for (uint32_t p = r.reu_addr >> 8; p <= (r.reu_addr + r.length - 1) >> 8; ++p)
+                pages[p] = 1;
+            none.dma(r.length);
+            for (Cache& c : models)
+                c.replay(r);
+        }
+    }
+    fclose(f);
+    for (Cache& c : models)
+        c.flush();
+
+    uint32_t touched = 0;
+    for (const uint8_t p : pages)
+        touched += p;
+    printf("%s: %llu transfers (%llu loads, %llu stores, %llu fills), %llu bytes loaded, %llu stored, %u KB of the REU touched\n",
+           path, (unsigned long long)none.transfers, (unsigned long long)loads, (unsigned long long)stores,
+           (unsigned long long)fills, (unsigned long long)load_bytes, (unsigned long long)store_bytes, touched / 4);
+    printf("setup %u cycles per DMA transfer, lookup %u cycles per hit\n\n", SETUP, LOOKUP);
+    printf("%-28s %12s %12s %7s %12s %14s %14s %8s\n", "model", "hits", "misses", "hit %", "DMA xfers", "DMA bytes",
+           "cycles", "speedup");
+    printf("%-28s %12s %12s %7s %12llu %14llu %14llu %8s\n", "none", "-", "-", "-", (unsigned long long)none.transfers,
+           (unsigned long long)none.bytes, (unsigned long long)none.cycles, "1.00");
+    for (const Cache& c : models) {
+        const Stats& s = c.stats;
+        const uint64_t lines = s.hits + s.misses;
+        printf("%-28s %12llu %12llu %7.2f %12llu %14llu %14llu %8.2f\n", c.name, (unsigned long long)s.hits,
+               (unsigned long long)s.misses, lines ? 100.0 * s.hits / lines : 0.0, (unsigned long long)s.transfers,
+               (unsigned long long)s.bytes, (unsigned long long)s.cycles, (double)none.cycles / s.cycles);
+    }
+    printf("\nREU transfers without a cache take %.1f s on a PAL C64 (985248 Hz)\n", none.cycles / 985248.0);
+    return 0;
+}